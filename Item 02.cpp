@@ -81,6 +81,14 @@ auto reset = [&v](const auto& newValue) { v = newValue; }; // C++14
 
 reset({ 1, 2, 3 }); // error! can't deduce type for { 1, 2, 3 }
 
+// Naming the element type instead of deducing a std::initializer_list works in both places (see Item 7 for makeVector)
+auto createVector()
+{
+    return makeVector<int>(1, 2, 3);            // std::vector<int>, built without an initializer_list
+}
+
+reset(makeVector<int>(1, 2, 3));                // Fine: newValue is a std::vector<int>
+
 
 /**
  * Practical Implications:
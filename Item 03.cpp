@@ -1,4 +1,11 @@
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 /**
  * Understand decltype.
  *
@@ -66,6 +73,110 @@ decltype(auto) authAndAccess(Container&& c, Index i)
 }
 
 
+/**
+ * Rvalue Containers:
+ * Forwarding c doesn't make std::forward<Container>(c)[i] an rvalue for the standard containers, because their
+ * operator[] isn't ref-qualified: it returns an lvalue reference either way. For an rvalue container, decltype(auto)
+ * therefore returns a reference to an element of a temporary that's destroyed at the end of the full expression.
+ *
+ * Applying the pattern of Item 12's ref-qualified accessors fixes that: lvalue containers still get a reference, while
+ * rvalue containers get the element by value, move-constructed out of the container before it goes away. if constexpr
+ * picks one return statement at compile time, so decltype(auto) deduces a reference type for the first and a
+ * non-reference type for the second.
+*/
+// C++17
+template<typename Container, typename Index>
+decltype(auto) authAndAccess(Container&& c, Index i)
+{
+    authenticateUser();
+
+    if constexpr (std::is_lvalue_reference_v<Container>)
+    {
+        return c[i];                                            // decltype(c[i]) is a reference into c
+    }
+    else
+    {
+        return std::decay_t<decltype(c[i])>(std::move(c[i]));  // A prvalue, so returned by value
+    }
+}
+
+std::deque<std::string> d;
+std::deque<std::string> makeStringDeque();      // Factory function
+
+authAndAccess(d, 5) = "Hello";                  // Authenticate user, assign to d[5]
+auto s = authAndAccess(makeStringDeque(), 5);   // Move-constructs s from element 5 of the temporary deque
+
+
+/**
+ * Authenticating Once per Session:
+ * authAndAccess authenticates on every call, which dominates the cost of a loop of reads. AuthenticatedAccess
+ * authenticates a session token once, in its constructor, and then serves any number of reads for as long as it's in
+ * scope. It holds nothing but the container (a reference for lvalues, the moved-in container for rvalues) and the
+ * token, so creating one doesn't allocate.
+ *
+ * - operator[] returns std::forward<Container>(c)[i] through decltype(auto), so its return type is exactly the one the
+ *   C++14 authAndAccess would return for the same arguments.
+ *
+ * - gather reads the elements at a span of indices into an output iterator, one pass and no per-element
+ *   authentication.
+*/
+using SessionToken = std::uint64_t;
+
+void authenticateSession(SessionToken token);   // Throws if token isn't valid
+
+template<typename Container>
+class AuthenticatedAccess
+{
+    public:
+        AuthenticatedAccess(Container&& c, SessionToken token)
+            : c(std::forward<Container>(c)), token(token)
+        {
+            authenticateSession(token);
+        }
+
+        AuthenticatedAccess(const AuthenticatedAccess&) = delete;
+        AuthenticatedAccess& operator=(const AuthenticatedAccess&) = delete;
+
+        template<typename Index>
+        decltype(auto) operator[](Index i)
+        {
+            return std::forward<Container>(c)[i];
+        }
+
+        template<typename OutputIt>
+        OutputIt gather(std::span<const std::size_t> indices, OutputIt out)
+        {
+            for (auto i : indices)
+            {
+                *out++ = c[i];
+            }
+
+            return out;
+        }
+
+        SessionToken session() const noexcept { return token; }
+
+    private:
+        Container c;                            // Container& for lvalues, Container for rvalues
+        SessionToken token;
+};
+
+// Container is deduced as for authAndAccess's universal reference
+template<typename Container>
+AuthenticatedAccess<Container> authenticate(Container&& c, SessionToken token)
+{
+    return { std::forward<Container>(c), token };   // Guaranteed elision; AuthenticatedAccess isn't copyable
+}
+
+std::vector<std::string> names;
+std::vector<std::size_t> wanted { 3, 14, 15, 92 };
+std::vector<std::string> out(wanted.size());
+
+auto access = authenticate(names, token);       // One authentication
+access[5] = "Hello";                            // Returns std::string&, as authAndAccess(names, 5) would
+access.gather(wanted, out.begin());             // Four reads, no further authentication
+
+
 /**
  * Special Cases and Surprises:
  * Applying decltype to a name yields its declared type. However, for more complex lvalue expressions, decltype always
@@ -1,4 +1,10 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iomanip>
 #include <iostream>
+#include <source_location>
+#include <string_view>
 #include <typeinfo>
 /**
  * Know how to view deduced type.
@@ -35,3 +41,150 @@ int x { 0 }, y { 0 };
 
 std::cout << typeid(x).name() << '\n';      // display types for x and y
 std::cout << typeid(y).name() << '\n';
+
+
+/**
+ * Compile-Time Type Names:
+ * std::type_info::name is mangled on GCC and Clang, drops references and cv qualifiers (it's specified to treat
+ * const int& like int), and needs RTTI at run time. A function template's own name, as the compiler spells it for
+ * std::source_location::function_name, contains the template argument exactly as deduced, so typeName slices it out in
+ * a constant expression. GCC and Clang spell it "[with T = ...; ...]" and "[T = ...]"; MSVC spells it
+ * "typeName<...>(void)". The result is a std::string_view into the function name's static storage.
+*/
+template<typename T>
+constexpr std::string_view typeName()
+{
+    // Not a constexpr variable: GCC leaves the template arguments out of the name in that context
+    const std::string_view function = std::source_location::current().function_name();
+    const std::string_view gccClang = "T = ";
+    const std::string_view msvc = "typeName<";
+
+    if (auto first = function.find(gccClang); first != std::string_view::npos)
+    {
+        first += gccClang.size();
+        const auto last = function.find(';', first) != std::string_view::npos ? function.find(';', first)
+                                                                              : function.rfind(']');
+
+        return function.substr(first, last - first);
+    }
+
+    const auto first = function.find(msvc) + msvc.size();
+
+    return function.substr(first, function.rfind(">(void)") - first);
+}
+
+static_assert(typeName<int>() == "int");
+
+template<typename T>
+void f(const T& param)
+{
+    std::cout << "T = " << typeName<T>() << '\n';                         // Shows T
+    std::cout << "param = " << typeName<decltype(param)>() << '\n';       // Shows param's type
+}
+
+std::cout << typeName<decltype(x)>() << '\n';                  // int
+std::cout << typeName<decltype((x))>() << '\n';                // int&, which typeid would report as int
+
+
+/**
+ * Reporting Layouts:
+ * C++20 can't enumerate a class's members, so reportLayout is given their types in declaration order, and names for
+ * the printout. layoutOf places them the way the usual ABIs do, each at the next offset that satisfies its alignment,
+ * and reportLayout static_asserts that the result has the class's real size and alignment. A wrong list, a base class,
+ * a virtual function or a bitfield makes the assert fire rather than the report lie. Since it needs only the types,
+ * it works for private members, which offsetof couldn't name.
+ *
+ * The report shows each member's offset, size and type, every hole between members and at the end, the total padding,
+ * and where 64-byte cache lines begin, so a hot member that straddles a line, or shares one with a member written by
+ * another thread, stands out. GCC's -Wpadded flags the same holes as warnings, without the totals.
+*/
+struct FieldLayout
+{
+    std::string_view type;
+    std::size_t offset, size, alignment;
+};
+
+template<typename... Members>
+constexpr std::array<FieldLayout, sizeof...(Members)> layoutOf()
+{
+    std::array<FieldLayout, sizeof...(Members)> fields { FieldLayout { typeName<Members>(), 0, sizeof(Members),
+                                                                       alignof(Members) }... };
+    std::size_t offset = 0;
+
+    for (auto& field : fields)
+    {
+        field.offset = (offset + field.alignment - 1) / field.alignment * field.alignment;
+        offset = field.offset + field.size;
+    }
+
+    return fields;
+}
+
+template<typename T, typename... Members>
+void reportLayout(std::string_view name, const std::array<std::string_view, sizeof...(Members)>& memberNames)
+{
+    constexpr std::size_t cacheLine = 64;
+    constexpr auto fields = layoutOf<Members...>();
+    constexpr std::size_t alignment = std::max({ std::size_t { 1 }, alignof(Members)... });
+    constexpr std::size_t end = fields.empty() ? 0 : fields.back().offset + fields.back().size;
+
+    static_assert((end + alignment - 1) / alignment * alignment == sizeof(T) && alignment == alignof(T),
+                  "Members don't reproduce T's layout; check their types and order");
+
+    std::size_t padding = 0, offset = 0;
+
+    auto hole = [&](std::size_t until)
+    {
+        if (until > offset)
+        {
+            std::cout << "    " << std::setw(6) << offset << std::setw(6) << until - offset << "  (padding)\n";
+            padding += until - offset;
+        }
+    };
+
+    std::cout << name << ":\n";
+
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        hole(fields[i].offset);
+
+        if (fields[i].offset % cacheLine == 0 || fields[i].offset / cacheLine != offset / cacheLine)
+        {
+            std::cout << "    -- cache line " << fields[i].offset / cacheLine << " --\n";
+        }
+
+        // Members bigger than a line span several anyway; only smaller ones are worth flagging
+        const bool straddles = fields[i].size <= cacheLine
+                               && fields[i].offset / cacheLine != (fields[i].offset + fields[i].size - 1) / cacheLine;
+
+        std::cout << "    " << std::setw(6) << fields[i].offset << std::setw(6) << fields[i].size << "  "
+                  << fields[i].type << ' ' << memberNames[i] << (straddles ? "  (straddles a cache line)" : "")
+                  << '\n';
+
+        offset = fields[i].offset + fields[i].size;
+    }
+
+    hole(sizeof(T));
+
+    std::cout << "    " << sizeof(T) << " bytes, alignment " << alignof(T) << ", " << padding << " bytes of padding, "
+              << (sizeof(T) + cacheLine - 1) / cacheLine << " cache lines\n";
+}
+
+struct Sample
+{
+    char flag;
+    double value;
+    char kind;
+};
+
+reportLayout<Sample, char, double, char>("Sample", { "flag", "value", "kind" });   // 24 bytes, 14 of them padding
+
+// IPv4Header (Item 30) is all bitfields, so it's described as the one std::uint32_t they're packed into
+reportLayout<IPv4Header, std::uint32_t>("IPv4Header", { "version..totalLength" });
+
+// Point (Item 16): the doubles start a fresh cache line after ShardedCounter's slots, then 48 bytes of tail padding
+reportLayout<Point, ShardedCounter, double, double>("Point", { "callCount", "x", "y" });
+
+// In "widget.cpp", inside a Widget member function, since Impl is private to Widget (see Item 22)
+reportLayout<Impl, std::string, std::vector<double>, Gadget, Gadget, Gadget>("Widget::Impl",
+                                                                            { "name", "data", "g1", "g2", "g3" });
@@ -1,5 +1,15 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <queue>
+#include <random>
+#include <set>
+#include <type_traits>
+#include <string>
+#include <utility>
+#include <vector>
 /**
  * Prefer auto to explicit type declarations.
  *
@@ -88,4 +98,219 @@ auto sz = v.size();             // Using auto ensures sz's type is std::vector<i
  * In conclusion, auto in C++ is presented as a feature that reduces errors and verbosity, simplifies code, and makes it
  * more adaptable to changes. However, the author acknowledges that explicit type declarations may still be appropriate
  * in some cases, leaving the decision to the programmer's judgment.
-*/
\ No newline at end of file
+*/
+
+
+/**
+ * Measuring the Comparators:
+ * The claim above is easy to check on the containers that take a comparator. Each benchmark uses 10,000 widgets owned
+ * by std::unique_ptrs, with keys in random order, and one of three comparators of the same logic (see Item 24 for
+ * registerBenchmark):
+ *
+ * - the auto closure: its type is unique, so std::sort and friends are instantiated for it and can inline the call.
+ *
+ * - std::function: every comparison is an indirect call through the type erasure, which the optimizer can't see
+ *   through.
+ *
+ * - a function pointer: also an indirect call. It could only be inlined if the optimizer proved the pointer constant
+ *   where the algorithm is instantiated, which it rarely does.
+ *
+ * The sort cases reshuffle before sorting, so "shuffle only" is the part to subtract. The set case looks up 1,000 keys
+ * in a std::set of the widgets; the priority_queue case pushes every widget and pops them all, moving each one out.
+ *
+ * Expect the closure to sort fastest, std::function slowest and the function pointer in between. Set lookups are
+ * dominated by the tree walk's cache misses, so the three should come out close. The priority_queue cases are the most
+ * sensitive to code layout, so compare them across several builds before drawing conclusions.
+ *
+ * ---------------------------------------------------------------------------------------------------------------------
+ *
+ * Sorting Without the Indirection:
+ * Even the inlined closure follows two pointers per comparison, to two widgets scattered across the heap. sortByKey
+ * copies each widget's key into a parallel vector next to the widget's index, sorts that contiguous vector, and then
+ * moves the std::unique_ptrs into the sorted order in one pass. The comparisons never touch the widgets, and the
+ * pointers are moved once rather than on every swap. An unsigned key of up to 32 bits is packed with its index into a
+ * single 64-bit integer. The "parallel key vector" case times all of it, building the keys and the final pass
+ * included, against the closure sort. Its advantage should grow once the widgets no longer fit in cache.
+*/
+struct SortableWidget
+{
+    std::uint32_t key;
+
+    friend bool operator<(const SortableWidget& lhs, const SortableWidget& rhs) { return lhs.key < rhs.key; }
+};
+
+using WidgetPtr = std::unique_ptr<SortableWidget>;
+
+auto derefWidgetLess = [](const WidgetPtr& p1, const WidgetPtr& p2) { return *p1 < *p2; };
+
+bool derefWidgetLessFn(const WidgetPtr& p1, const WidgetPtr& p2)
+{
+    return *p1 < *p2;
+}
+
+template<typename T, typename KeyFunc>
+void sortByKey(std::vector<std::unique_ptr<T>>& v, KeyFunc key)
+{
+    using Key = std::decay_t<decltype(key(*v.front()))>;
+
+    // A key of up to 32 unsigned bits and the index pack into one 64-bit integer, which sorts fastest of all
+    constexpr bool packed = std::is_unsigned_v<Key> && sizeof(Key) <= sizeof(std::uint32_t);
+    using Entry = std::conditional_t<packed, std::uint64_t, std::pair<Key, std::uint32_t>>;
+
+    std::vector<Entry> keys;
+    keys.reserve(v.size());
+
+    for (std::uint32_t i = 0; i < v.size(); ++i)
+    {
+        if constexpr (packed)
+        {
+            keys.push_back(std::uint64_t { key(*v[i]) } << 32 | i);
+        }
+        else
+        {
+            keys.emplace_back(key(*v[i]), i);
+        }
+    }
+
+    std::sort(keys.begin(), keys.end());            // Ties are broken by index, so the result is stable
+
+    std::vector<std::unique_ptr<T>> sorted;
+    sorted.reserve(v.size());
+
+    for (const auto& entry : keys)
+    {
+        if constexpr (packed)
+        {
+            sorted.push_back(std::move(v[static_cast<std::uint32_t>(entry)]));
+        }
+        else
+        {
+            sorted.push_back(std::move(v[entry.second]));
+        }
+    }
+
+    v = std::move(sorted);
+}
+
+// std::priority_queue can only copy its top, not move it; take moves it out through the protected members
+template<typename T, typename Compare>
+class DrainablePriorityQueue: public std::priority_queue<T, std::vector<T>, Compare>
+{
+    public:
+        using std::priority_queue<T, std::vector<T>, Compare>::priority_queue;
+
+        T take()
+        {
+            std::pop_heap(this->c.begin(), this->c.end(), this->comp);     // Top goes to the back, out of the heap
+
+            T top = std::move(this->c.back());
+            this->c.pop_back();
+
+            return top;
+        }
+};
+
+constexpr std::size_t benchWidgetCount = 10'000;
+
+std::vector<WidgetPtr> makeShuffledWidgets()
+{
+    std::vector<WidgetPtr> widgets;
+    widgets.reserve(benchWidgetCount);
+
+    for (std::uint32_t i = 0; i < benchWidgetCount; ++i)
+    {
+        widgets.push_back(std::make_unique<SortableWidget>(SortableWidget { i }));
+    }
+
+    std::shuffle(widgets.begin(), widgets.end(), std::mt19937 { 5 });
+
+    return widgets;
+}
+
+template<typename Compare>
+void registerComparatorBenchmarks(const std::string& comparator, Compare compare)
+{
+    // Benchmarks are stored in std::functions, which have to be copyable, so the widgets are static locals
+    registerBenchmark("Item 5/sort, " + comparator, [compare]
+    {
+        static auto v = makeShuffledWidgets();
+        static std::mt19937 rng { 5 };
+
+        std::shuffle(v.begin(), v.end(), rng);
+        std::sort(v.begin(), v.end(), compare);
+
+        return v.front()->key;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 5/set find, " + comparator, [compare]
+    {
+        static const auto probes = makeShuffledWidgets();
+        static const auto set = [compare]
+        {
+            auto v = makeShuffledWidgets();
+
+            return std::set<WidgetPtr, Compare>(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()),
+                                                compare);
+        }();
+
+        std::size_t found = 0;
+
+        for (std::size_t i = 0; i < 1'000; ++i)
+        {
+            found += set.count(probes[i]);
+        }
+
+        return found;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 5/priority_queue, " + comparator, [compare]
+    {
+        static auto v = makeShuffledWidgets();
+
+        DrainablePriorityQueue<WidgetPtr, Compare> queue(compare);
+
+        for (auto& p : v)
+        {
+            queue.push(std::move(p));
+        }
+
+        for (auto& p : v)
+        {
+            p = queue.take();
+        }
+
+        return v.front()->key;
+    }, batchBenchmark);
+}
+
+inline const bool item05Registered = []
+{
+    using FunctionCompare = std::function<bool(const WidgetPtr&, const WidgetPtr&)>;
+
+    registerComparatorBenchmarks("auto closure", derefWidgetLess);
+    registerComparatorBenchmarks("std::function", FunctionCompare(derefWidgetLess));
+    registerComparatorBenchmarks("function pointer", &derefWidgetLessFn);
+
+    registerBenchmark("Item 5/sort, shuffle only", []
+    {
+        static auto v = makeShuffledWidgets();
+        static std::mt19937 rng { 5 };
+
+        std::shuffle(v.begin(), v.end(), rng);
+
+        return v.front()->key;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 5/sort, parallel key vector", []
+    {
+        static auto v = makeShuffledWidgets();
+        static std::mt19937 rng { 5 };
+
+        std::shuffle(v.begin(), v.end(), rng);
+        sortByKey(v, [](const SortableWidget& w) { return w.key; });
+
+        return v.front()->key;
+    }, batchBenchmark);
+
+    return true;
+}();
@@ -1,3 +1,11 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
 #include <vector>
 /**
  * Use the explicitly typed initializer idiom when auto deduces undesired types.
@@ -54,4 +62,297 @@ auto highPriority = static_cast<bool>(features(w)[5]);
 double calcEpsilon();                           // Return tolerance value
 float ep = calcEpsilon();                       // Implicitly convert double → float
 
-auto ep = static_cast<float>(calcEpsilon());    // Idiom
\ No newline at end of file
+auto ep = static_cast<float>(calcEpsilon());    // Idiom
+
+
+/**
+ * Avoiding the Proxy Altogether:
+ * The idiom fixes the deduced type, but not the two costs underneath it: features returns a whole std::vector<bool> by
+ * value (an allocation per call), and std::vector<bool> only offers bit-at-a-time access, so counting or combining
+ * flags is a loop over proxies.
+ *
+ * FeatureSet<N> is a fixed-size packed bitset designed so neither problem arises:
+ *
+ * - operator[] returns a plain bool. There is no proxy, so auto deduces bool and nothing can dangle. Bits are changed
+ *   through set and reset, not through a reference-like object.
+ *
+ * - Storage is an array of 64-bit words, exposed through words(), so whole-set operations work a word at a time.
+ *   count uses std::popcount (one POPCNT instruction per word where the target supports it), findFirst uses
+ *   std::countr_zero, and the and/or/contains loops are simple enough for compilers to vectorize at -O2/-O3.
+ *
+ * - The size is part of the type, so there's no allocation, and a FeatureSet can be returned by reference from
+ *   wherever it's stored (see FeatureTable below).
+ *
+ * Portable std::bit functions rather than intrinsics keep this usable on every target; with the right -march flags the
+ * compiler emits the SIMD forms itself.
+*/
+template<std::size_t N>
+class FeatureSet
+{
+    public:
+        static constexpr std::size_t wordCount = (N + 63) / 64;
+
+        constexpr bool operator[](std::size_t pos) const noexcept
+        {
+            return (bits[pos / 64] >> (pos % 64)) & 1u;
+        }
+
+        constexpr void set(std::size_t pos, bool value = true) noexcept
+        {
+            auto mask = std::uint64_t { 1 } << (pos % 64);
+            bits[pos / 64] = value ? (bits[pos / 64] | mask) : (bits[pos / 64] & ~mask);
+        }
+
+        constexpr void reset(std::size_t pos) noexcept
+        {
+            set(pos, false);
+        }
+
+        constexpr std::size_t count() const noexcept
+        {
+            std::size_t total = 0;
+
+            for (auto word : bits)
+            {
+                total += std::popcount(word);
+            }
+
+            return total;
+        }
+
+        // Index of the lowest set bit, or N if none is set
+        constexpr std::size_t findFirst() const noexcept
+        {
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                if (bits[i])
+                {
+                    return i * 64 + std::countr_zero(bits[i]);
+                }
+            }
+
+            return N;
+        }
+
+        // Every feature in required is also in *this
+        constexpr bool contains(const FeatureSet& required) const noexcept
+        {
+            std::uint64_t missing = 0;
+
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                missing |= required.bits[i] & ~bits[i];         // No early exit, so the loop vectorizes
+            }
+
+            return missing == 0;
+        }
+
+        constexpr FeatureSet& operator&=(const FeatureSet& rhs) noexcept
+        {
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                bits[i] &= rhs.bits[i];
+            }
+
+            return *this;
+        }
+
+        constexpr FeatureSet& operator|=(const FeatureSet& rhs) noexcept
+        {
+            for (std::size_t i = 0; i < wordCount; ++i)
+            {
+                bits[i] |= rhs.bits[i];
+            }
+
+            return *this;
+        }
+
+        constexpr std::span<const std::uint64_t, wordCount> words() const noexcept
+        {
+            return bits;
+        }
+
+    private:
+        std::array<std::uint64_t, wordCount> bits { };         // Bits past N stay zero
+};
+
+
+/**
+ * Many Widgets at Once:
+ * FeatureTable keeps one FeatureSet per widget in a contiguous array. features returns a reference to the stored set,
+ * so a query neither allocates nor copies, and the batch operations stream through the array:
+ *
+ * - countWith counts the widgets that have every feature in a required set (an AND per word).
+ *
+ * - common and any fold the sets with AND and OR: the features every widget has, and the features some widget has.
+*/
+template<std::size_t N>
+class FeatureTable
+{
+    public:
+        explicit FeatureTable(std::size_t widgetCount) : sets(widgetCount) { }
+
+        const FeatureSet<N>& features(std::size_t widget) const noexcept { return sets[widget]; }
+        FeatureSet<N>& features(std::size_t widget) noexcept { return sets[widget]; }
+
+        std::size_t countWith(const FeatureSet<N>& required) const noexcept
+        {
+            return std::count_if(sets.begin(), sets.end(), [&](const auto& fs) { return fs.contains(required); });
+        }
+
+        FeatureSet<N> common() const noexcept
+        {
+            FeatureSet<N> result;
+
+            for (std::size_t pos = 0; pos < N; ++pos)
+            {
+                result.set(pos);
+            }
+
+            for (const auto& fs : sets)
+            {
+                result &= fs;
+            }
+
+            return result;
+        }
+
+        FeatureSet<N> any() const noexcept
+        {
+            FeatureSet<N> result;
+
+            for (const auto& fs : sets)
+            {
+                result |= fs;
+            }
+
+            return result;
+        }
+
+        std::size_t size() const noexcept { return sets.size(); }
+
+    private:
+        std::vector<FeatureSet<N>> sets;
+};
+
+constexpr std::size_t featureCount = 512;
+
+const FeatureSet<featureCount>& features(const FeatureTable<featureCount>& table, std::size_t widget);
+
+auto highPriority = features(table, widget)[5];            // bool; nothing to dangle
+
+
+/**
+ * Benchmarks:
+ * 10,000 widgets with 512 features each, stored as std::vector<bool>, std::bitset<512> and FeatureSet<512> (see Item 24
+ * for registerBenchmark). Each case reads one flag per widget, counts all set flags, or counts the widgets that have
+ * eight required features. std::bitset also stores words, but hides them: its count is fast, but a "has all of these"
+ * query has to build a temporary ((fs & required) == required). std::vector<bool> does everything bit by bit. Each
+ * case is already a pass over every widget, so all of them run with batchBenchmark's few single-call samples.
+*/
+constexpr std::size_t benchWidgetCount = 10'000;
+
+inline const bool item06Registered = []
+{
+    static std::vector<std::vector<bool>> asVectorBool(benchWidgetCount, std::vector<bool>(featureCount));
+    static std::vector<std::bitset<featureCount>> asBitset(benchWidgetCount);
+    static FeatureTable<featureCount> asFeatureTable(benchWidgetCount);
+
+    static FeatureSet<featureCount> required;
+    static std::bitset<featureCount> requiredBitset;
+    static const std::array<std::size_t, 8> requiredPositions { 3, 5, 64, 100, 200, 300, 400, 511 };
+
+    for (auto pos : requiredPositions)
+    {
+        required.set(pos);
+        requiredBitset.set(pos);
+    }
+
+    // Deterministic pseudo-random flags, the same in all three representations
+    std::uint64_t state = 0x9E3779B97F4A7C15;
+
+    for (std::size_t w = 0; w < benchWidgetCount; ++w)
+    {
+        for (std::size_t pos = 0; pos < featureCount; ++pos)
+        {
+            state = state * 6364136223846793005 + 1442695040888963407;
+            bool on = (state >> 60) != 0;               // 15 in 16 flags set, so some widgets have all required
+
+            asVectorBool[w][pos] = on;
+            asBitset[w][pos] = on;
+            asFeatureTable.features(w).set(pos, on);
+        }
+    }
+
+    registerBenchmark("Item 6/flag 5, vector<bool>", []
+    {
+        return std::count_if(asVectorBool.begin(), asVectorBool.end(), [](const auto& fs) { return bool(fs[5]); });
+    }, batchBenchmark);
+    registerBenchmark("Item 6/flag 5, bitset", []
+    {
+        return std::count_if(asBitset.begin(), asBitset.end(), [](const auto& fs) { return fs[5]; });
+    }, batchBenchmark);
+    registerBenchmark("Item 6/flag 5, FeatureSet", []
+    {
+        std::size_t n = 0;
+
+        for (std::size_t w = 0; w < benchWidgetCount; ++w)
+        {
+            n += asFeatureTable.features(w)[5];
+        }
+
+        return n;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 6/popcount, vector<bool>", []
+    {
+        std::size_t n = 0;
+
+        for (const auto& fs : asVectorBool)
+        {
+            n += std::count(fs.begin(), fs.end(), true);
+        }
+
+        return n;
+    }, batchBenchmark);
+    registerBenchmark("Item 6/popcount, bitset", []
+    {
+        std::size_t n = 0;
+
+        for (const auto& fs : asBitset)
+        {
+            n += fs.count();
+        }
+
+        return n;
+    }, batchBenchmark);
+    registerBenchmark("Item 6/popcount, FeatureSet", []
+    {
+        std::size_t n = 0;
+
+        for (std::size_t w = 0; w < benchWidgetCount; ++w)
+        {
+            n += asFeatureTable.features(w).count();
+        }
+
+        return n;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 6/has all required, vector<bool>", []
+    {
+        return std::count_if(asVectorBool.begin(), asVectorBool.end(), [](const auto& fs)
+                             {
+                                 return std::all_of(requiredPositions.begin(), requiredPositions.end(),
+                                                    [&fs](auto pos) { return bool(fs[pos]); });
+                             });
+    }, batchBenchmark);
+    registerBenchmark("Item 6/has all required, bitset", []
+    {
+        return std::count_if(asBitset.begin(), asBitset.end(),
+                             [](const auto& fs) { return (fs & requiredBitset) == requiredBitset; });
+    }, batchBenchmark);
+    registerBenchmark("Item 6/has all required, FeatureSet", [] { return asFeatureTable.countWith(required); },
+                      batchBenchmark);
+
+    return true;
+}();
@@ -1,4 +1,11 @@
 #include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 #include <utility>
 /**
@@ -94,6 +101,102 @@ std::vector<int> v1(10, 20);
 std::vector<int> v2 { 10, 20 };
 
 
+
+/**
+ * Building Vectors Without std::initializer_list:
+ * An initializer_list's elements are const, so v2 { 10, 20 } copies each element from the list into the vector. That's
+ * harmless for ints, costs an allocation per element for long std::strings, and doesn't compile for move-only types
+ * such as std::unique_ptr. The two forms below keep the v1/v2 distinction, but in their names rather than in the shape
+ * of the brackets:
+ *
+ * - makeVector<T>(args...) is the v2 form: one element per argument. It reserves exactly sizeof...(args) elements and
+ *   emplaces each argument by perfect forwarding, so rvalues are moved in and nothing is copied twice.
+ *
+ * - makeFilledVector<T>(count, args...) is the v1 form: count elements, each constructed from args.
+ *
+ * Both construct elements with parentheses, the way emplace_back does, so an element type's own initializer_list
+ * constructor is never picked by accident: makeVector<std::vector<int>>(10) holds one vector of ten zeros.
+*/
+template<typename T, typename... Args>
+std::vector<T> makeVector(Args&&... args)
+{
+    std::vector<T> v;
+    v.reserve(sizeof...(Args));
+
+    (v.emplace_back(std::forward<Args>(args)), ...);
+
+    return v;
+}
+
+template<typename T, typename... Args>
+std::vector<T> makeFilledVector(std::size_t count, const Args&... args)
+{
+    std::vector<T> v;
+    v.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        v.emplace_back(args...);                            // Not forwarded: the arguments are used count times
+    }
+
+    return v;
+}
+
+auto v3 = makeFilledVector<int>(10, 20);                    // Like v1: 10 elements, all 20
+auto v4 = makeVector<int>(10, 20);                          // Like v2: elements 10 and 20
+
+// Move-only elements, which an initializer_list can't hold
+auto ptrs = makeVector<std::unique_ptr<Widget>>(std::make_unique<Widget>(), std::make_unique<Widget>());
+
+
+/**
+ * Benchmarks:
+ * Each case builds a vector of eight elements (see Item 24 for registerBenchmark). The std::string cases use 32
+ * characters, past the small string buffer: braces allocate each string once as a temporary and again when the list
+ * is copied into the vector, while makeVector moves each temporary in. The std::unique_ptr cases compare makeVector
+ * with push_back into a vector that wasn't reserved, since braces aren't an option.
+*/
+inline const bool item07Registered = []
+{
+    registerBenchmark("Item 7/std::string, braces", []
+    {
+        auto s = [] { return std::string(32, 'x'); };
+        std::vector<std::string> v { s(), s(), s(), s(), s(), s(), s(), s() };
+
+        return v.size();
+    });
+
+    registerBenchmark("Item 7/std::string, makeVector", []
+    {
+        auto s = [] { return std::string(32, 'x'); };
+        auto v = makeVector<std::string>(s(), s(), s(), s(), s(), s(), s(), s());
+
+        return v.size();
+    });
+
+    registerBenchmark("Item 7/std::unique_ptr, push_back", []
+    {
+        std::vector<std::unique_ptr<int>> v;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            v.push_back(std::make_unique<int>(i));
+        }
+
+        return v.size();
+    });
+
+    registerBenchmark("Item 7/std::unique_ptr, makeVector", []
+    {
+        auto p = [] { return std::make_unique<int>(0); };
+        auto v = makeVector<std::unique_ptr<int>>(p(), p(), p(), p(), p(), p(), p(), p());
+
+        return v.size();
+    });
+
+    return true;
+}();
+
 /**
  * For template authors, this choice can be challenging, as it's not always clear which method should be used. Functions
  * like std::make_unique and std::make_shared solve this by internally using parentheses and documenting this choice.
@@ -103,4 +206,150 @@ void doSomeWork(Ts&& ... params)
 {
     T localObject(std::forward<Ts>(params)...);             // Using parens
     T localObject { std::forward<Ts>(params)... };          // Using braces
-}
\ No newline at end of file
+}
+
+
+/**
+ * Letting the Caller Choose:
+ * doSomeWork has to commit to one syntax, and whoever calls it can't say which one they meant. With a tag the choice
+ * moves to the call site and is resolved at compile time: parenInit, braceInit or aggregateInit, where aggregateInit is
+ * braces plus a static_assert that T really is an aggregate, so a later constructor added to T can't silently change
+ * what the braces do.
+ *
+ * - construct<T>(init, args...) returns a prvalue, so since C++17 the caller's object is initialized directly from the
+ *   arguments, with no temporary to move from.
+ *
+ * - constructAt<T>(storage, init, args...) builds T with placement new in caller-provided storage: an aligned byte
+ *   buffer, or a slot from Item 21's FixedSizePool. The caller destroys it.
+ *
+ * - constructInto(optional, init, args...) emplaces into a std::optional. emplace forwards its arguments to
+ *   parentheses, so constructInto hands it a proxy whose conversion to T calls construct. T mustn't have a constructor
+ *   template that accepts the proxy itself, as the forwarding constructors in Items 26 and 27 would. Whether the
+ *   conversion's prvalue then initializes the optional's T in place depends on the compiler: the standard has
+ *   T(proxy) call T's move constructor with the converted temporary, and only the proposed resolution of CWG2327
+ *   elides that move. GCC implements it; Clang and MSVC move once, which is still no worse than opt = T(...) or
+ *   opt.emplace(T { ... }).
+*/
+struct ParenInit { };
+struct BraceInit { };
+struct AggregateInit { };
+
+inline constexpr ParenInit parenInit { };
+inline constexpr BraceInit braceInit { };
+inline constexpr AggregateInit aggregateInit { };
+
+template<typename T, typename Init, typename... Args>
+constexpr T construct(Init, Args&&... args)
+{
+    if constexpr (std::is_same_v<Init, ParenInit>)
+    {
+        return T(std::forward<Args>(args)...);
+    }
+    else
+    {
+        static_assert(!std::is_same_v<Init, AggregateInit> || std::is_aggregate_v<T>,
+                      "aggregateInit: T isn't an aggregate");
+
+        return T { std::forward<Args>(args)... };
+    }
+}
+
+template<typename T, typename Init, typename... Args>
+T* constructAt(void* storage, Init, Args&&... args)
+{
+    if constexpr (std::is_same_v<Init, ParenInit>)
+    {
+        return ::new (storage) T(std::forward<Args>(args)...);
+    }
+    else
+    {
+        static_assert(!std::is_same_v<Init, AggregateInit> || std::is_aggregate_v<T>,
+                      "aggregateInit: T isn't an aggregate");
+
+        return ::new (storage) T { std::forward<Args>(args)... };
+    }
+}
+
+template<typename T, typename Init, typename... Args>
+T& constructInto(std::optional<T>& opt, Init init, Args&&... args)
+{
+    // Holds references to the arguments until emplace converts it to T
+    struct Deferred
+    {
+        Init init;
+        std::tuple<Args&&...> args;
+
+        operator T() &&
+        {
+            return std::apply([this](auto&&... params)
+                              {
+                                  return construct<T>(init, std::forward<decltype(params)>(params)...);
+                              }, std::move(args));
+        }
+    };
+
+    return opt.emplace(Deferred { init, std::forward_as_tuple(std::forward<Args>(args)...) });
+}
+
+template<typename T, typename Init, typename... Ts>
+void doSomeWork(Init init, Ts&&... params)
+{
+    T localObject = construct<T>(init, std::forward<Ts>(params)...);
+}
+
+doSomeWork<std::vector<int>>(parenInit, 10, 20);          // localObject has 10 elements
+doSomeWork<std::vector<int>>(braceInit, 10, 20);          // localObject has 2 elements
+
+struct Point3 { double x, y, z; };
+
+auto p = construct<Point3>(aggregateInit, 1.0, 2.0, 3.0);
+alignas(Point3) std::byte buffer[sizeof(Point3)];
+auto pp = constructAt<Point3>(buffer, aggregateInit, 1.0, 2.0, 3.0);     // Trivially destructible; nothing to destroy
+
+auto& slots = FixedSizePool<sizeof(Point3), alignof(Point3)>::instance();     // See Item 21
+auto ps = constructAt<Point3>(slots.allocate(), parenInit, 1.0, 2.0, 3.0);    // C++20 parenthesized aggregate init
+slots.deallocate(ps);
+
+std::optional<std::vector<int>> ov;
+constructInto(ov, braceInit, 10, 20);                     // *ov has 2 elements, built in place
+
+
+/**
+ * Checking for Moves:
+ * checkConstructionPatterns uses Item 25's expectCounts on Item 42's TrackedString to hold each route to zero moves,
+ * next to the two ways of filling a std::optional that do move. constructInto is held to zero only where the compiler
+ * elides the conversion's move (see above).
+*/
+inline constexpr std::size_t constructIntoMoves =
+#if defined(__GNUC__) && !defined(__clang__)
+    0;                                                      // CWG2327's proposed resolution
+#else
+    1;
+#endif
+
+inline void checkConstructionPatterns()
+{
+    expectCounts("construct", { 0, 0 }, [] { auto s = construct<TrackedString>(parenInit, "name"); });
+    expectCounts("constructAt", { 0, 0 }, []
+    {
+        alignas(TrackedString) std::byte storage[sizeof(TrackedString)];
+        constructAt<TrackedString>(storage, braceInit, "name")->~TrackedString();
+    });
+    expectCounts("constructInto", { 0, constructIntoMoves }, []
+    {
+        std::optional<TrackedString> opt;
+        constructInto(opt, parenInit, "name");
+    });
+    expectCounts("optional = T(...)", { 0, 1 }, []
+    {
+        std::optional<TrackedString> opt;
+        opt = TrackedString("name");
+    });
+    expectCounts("optional emplace(T { ... })", { 0, 1 }, []
+    {
+        std::optional<TrackedString> opt;
+        opt.emplace(TrackedString { "name" });
+    });
+}
+
+checkConstructionPatterns();
@@ -1,6 +1,12 @@
+#include <cstddef>
 #include <cstdint>
+#include <numeric>
+#include <span>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 /**
  * Prefer scoped enums to unscoped enums.
  *
@@ -105,4 +111,150 @@ constexpr auto toUType(E enumerator) noexcept
     return static_cast<std::underlying_type_t<E>>(enumerator);
 }
 
-auto val = std::get<toUType(UserInfoFields::uiEmail)>(uInfo);
\ No newline at end of file
+auto val = std::get<toUType(UserInfoFields::uiEmail)>(uInfo);
+
+
+/**
+ * Enum-Indexed Columns:
+ * A std::vector<UserInfo> stores records as an array of structs: scanning only the reputations still drags both
+ * strings of every record through the cache, 72 bytes per 8-byte value with libstdc++.
+ *
+ * EnumTable stores a struct of arrays instead: one contiguous std::vector per field, with toUType mapping each
+ * enumerator to its column at compile time. A scan over column<UserInfoFields::uiReputation>() touches nothing but
+ * std::size_ts, which the compiler can also vectorize.
+ *
+ * Row access stays tuple-like. pushBack takes a Row (a std::tuple of the column types, so UserInfo for the
+ * instantiation below), row(i) returns a std::tuple of references into the columns, and get<Field>(i) reads one
+ * field of one row. The enumerators must be the column indices 0, 1, 2, ..., as they are for UserInfoFields.
+*/
+template<typename E, typename... Columns>
+class EnumTable
+{
+    public:
+        using Row = std::tuple<Columns...>;
+
+        void reserve(std::size_t n)
+        {
+            std::apply([n](auto&... column) { (column.reserve(n), ...); }, columns);
+        }
+
+        void pushBack(Row row)
+        {
+            pushBack(std::move(row), std::index_sequence_for<Columns...> { });
+        }
+
+        template<E Field>
+        std::span<const std::tuple_element_t<toUType(Field), Row>> column() const noexcept
+        {
+            return std::get<toUType(Field)>(columns);
+        }
+
+        template<E Field>
+        std::span<std::tuple_element_t<toUType(Field), Row>> column() noexcept
+        {
+            return std::get<toUType(Field)>(columns);
+        }
+
+        template<E Field>
+        const auto& get(std::size_t i) const noexcept
+        {
+            return std::get<toUType(Field)>(columns)[i];
+        }
+
+        std::tuple<const Columns&...> row(std::size_t i) const noexcept
+        {
+            return std::apply([i](const auto&... column) { return std::tie(column[i]...); }, columns);
+        }
+
+        std::size_t size() const noexcept { return std::get<0>(columns).size(); }
+
+    private:
+        template<std::size_t... Is>
+        void pushBack(Row&& row, std::index_sequence<Is...>)
+        {
+            (std::get<Is>(columns).push_back(std::get<Is>(std::move(row))), ...);
+        }
+
+        std::tuple<std::vector<Columns>...> columns;
+};
+
+using UserTable = EnumTable<UserInfoFields, std::string, std::string, std::size_t>;
+
+UserTable users;
+users.pushBack(UserInfo { "Ada", "ada@example.com", 42 });
+
+auto email = users.get<UserInfoFields::uiEmail>(0);                  // std::string
+auto [name, mail, reputation] = users.row(0);                        // References into the three columns
+auto reputations = users.column<UserInfoFields::uiReputation>();     // std::span<std::size_t>
+
+
+/**
+ * Benchmarks:
+ * One million users in each layout (see Item 24 for registerBenchmark). The reputation scan is where the SoA layout
+ * pays off: it reads 8 MB of contiguous std::size_ts instead of striding through 72 MB of records. The row case reads
+ * every field of every user, where the two layouts should be close, since both read all the data anyway.
+*/
+constexpr std::size_t userCount = 1'000'000;
+
+inline const bool item10Registered = []
+{
+    static std::vector<UserInfo> aos;
+    static UserTable soa;
+
+    aos.reserve(userCount);
+    soa.reserve(userCount);
+
+    for (std::size_t i = 0; i < userCount; ++i)
+    {
+        UserInfo info { "user" + std::to_string(i), "user" + std::to_string(i) + "@example.com", i % 1000 };
+
+        aos.push_back(info);
+        soa.pushBack(std::move(info));
+    }
+
+    registerBenchmark("Item 10/reputation scan, vector<UserInfo>", []
+    {
+        std::size_t total = 0;
+
+        for (const auto& info : aos)
+        {
+            total += std::get<toUType(UserInfoFields::uiReputation)>(info);
+        }
+
+        return total;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 10/reputation scan, EnumTable", []
+    {
+        auto reputations = soa.column<UserInfoFields::uiReputation>();
+
+        return std::accumulate(reputations.begin(), reputations.end(), std::size_t { 0 });
+    }, batchBenchmark);
+
+    registerBenchmark("Item 10/full rows, vector<UserInfo>", []
+    {
+        std::size_t total = 0;
+
+        for (const auto& [name, email, reputation] : aos)
+        {
+            total += name.size() + email.size() + reputation;
+        }
+
+        return total;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 10/full rows, EnumTable", []
+    {
+        std::size_t total = 0;
+
+        for (std::size_t i = 0; i < soa.size(); ++i)
+        {
+            auto [name, email, reputation] = soa.row(i);
+            total += name.size() + email.size() + reputation;
+        }
+
+        return total;
+    }, batchBenchmark);
+
+    return true;
+}();
@@ -1,3 +1,8 @@
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 /**
  * Declare overriding functions override.
@@ -67,10 +72,23 @@ class Widget
     public:
         using DataType = std::vector<double>;
 
+        Widget() = default;
+
+        explicit Widget(DataType v)
+            : values(std::move(v)) { }
+
         DataType& data() & { return values; }                   // For lvalue Widgets, return lvalue
 
+        const DataType& data() const& { return values; }        // For const lvalue Widgets, return const lvalue
+
         DataType data() && { return std::move(values); }        // For rvalue Widgets, return rvalue
 
+        std::span<const double> view() const& { return values; }    // Read-only view of an lvalue Widget; no copy
+
+        std::span<const double> view() const&& = delete;        // Would dangle once the temporary is destroyed
+
+        DataType take() { return std::exchange(values, { }); }  // Steal values; *this is left empty
+
         Widget makeWidget();
 
     private:
@@ -83,6 +101,76 @@ auto vals1 = w.data();              // Calls lvalue overload for Widget::data, c
 auto vals2 = makeWidget().data();   // Calls rvalue overload for Widget::data, move-constructs vals2
 
 
+/**
+ * A Family of Ref-Qualified Accessors:
+ * The lvalue overload of data returns a reference, but vals1 still copy-constructs, because the caller asked for a
+ * vector of its own. Callers that only read can ask for a view instead, and callers that are done with the Widget can
+ * take its data:
+ *
+ * - view() is the zero-copy read path. It returns a std::span over values, so nothing is allocated or copied. It's
+ *   deleted for rvalue Widgets, since the span would outlive the temporary it points into.
+ *
+ * - data() && moves values out, as before. The Widget is left in a valid but unspecified state, like any moved-from
+ *   object.
+ *
+ * - take() steals values from an lvalue Widget and leaves it empty rather than unspecified, so it can go on being used.
+ *   std::exchange moves the old value out and assigns the new one in a single expression.
+*/
+auto view1 = w.view();              // No copy; view1 refers to w's values
+auto vals3 = w.take();              // Move-constructs vals3; w.data() is now empty
+auto view2 = makeWidget().view();   // Error! view is deleted for rvalue Widgets
+
+
+/**
+ * Benchmarks:
+ * Each case gets a Widget's data through the accessor being measured and returns its size (see Item 24 for
+ * registerBenchmark). The copy cases allocate and copy the whole vector, so they scale with its size; a view is just a
+ * pointer and a length. The move and take cases move the data out and then back into the Widget, so they cost a few
+ * pointer assignments whatever the size.
+*/
+inline const bool item12Registered = []
+{
+    for (std::size_t n : { 16, 1'024, 1'048'576 })
+    {
+        const auto suffix = ", " + std::to_string(n) + " doubles";
+
+        registerBenchmark("Item 12/copy" + suffix, [w = Widget(Widget::DataType(n, 1.0))]
+        {
+            auto vals = w.data();
+
+            return vals.size();
+        }, n > 1'024 ? std::optional(batchBenchmark) : std::nullopt);
+
+        registerBenchmark("Item 12/view" + suffix, [w = Widget(Widget::DataType(n, 1.0))]
+        {
+            auto vals = w.view();
+
+            return vals.size();
+        }, n > 1'024 ? std::optional(batchBenchmark) : std::nullopt);
+
+        registerBenchmark("Item 12/move" + suffix, [w = Widget(Widget::DataType(n, 1.0))]() mutable
+        {
+            auto vals = std::move(w).data();
+            const auto size = vals.size();
+            w = Widget(std::move(vals));
+
+            return size;
+        }, n > 1'024 ? std::optional(batchBenchmark) : std::nullopt);
+
+        registerBenchmark("Item 12/take" + suffix, [w = Widget(Widget::DataType(n, 1.0))]() mutable
+        {
+            auto vals = w.take();
+            const auto size = vals.size();
+            w = Widget(std::move(vals));
+
+            return size;
+        }, n > 1'024 ? std::optional(batchBenchmark) : std::nullopt);
+    }
+
+    return true;
+}();
+
+
 
 /**
  * Legacy Code and Contextual Keywords:
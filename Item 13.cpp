@@ -1,3 +1,16 @@
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 /**
  * Prefer const_iterators to iterators.
@@ -85,4 +98,293 @@ template <class C>
 auto cbegin(const C& container) -> decltype(std::begin(container))
 {
     return std::begin(container);
-}
\ No newline at end of file
+}
+
+
+/**
+ * Making findAndInsert Scale:
+ * findAndInsert is O(n) twice over on a std::vector: std::find visits elements one at a time, and insert shifts
+ * everything after the insertion point. The insert's shift is inherent in the container; the search isn't. The
+ * overloads below keep findAndInsert's interface and semantics (insert before the first targetVal, or at the end if
+ * there is none) but search faster when the container allows it:
+ *
+ * - For contiguous containers of arithmetic types, the plain overload uses findContiguous, which compares a block of
+ *   16 elements with no early exit and only then looks for the match inside the block. That loop vectorizes; the
+ *   element-at-a-time std::find loop, with its exit on every element, generally doesn't. The target must already have
+ *   the element type: converting it would change what matches (1.5 would find 1 in a std::vector<int>), so any other
+ *   target type, like other containers, still uses std::find.
+ *
+ * - Passing an execution policy, e.g. std::execution::par_unseq, hands the search to the parallel algorithms. It only
+ *   pays for very large ranges, since starting the parallel work has a fixed cost. With libstdc++, link with -ltbb.
+ *
+ * - Passing sortedRange promises the range is sorted, so the search is a binary search: lower_bound finds the first
+ *   element not less than targetVal, which is the first targetVal if there is one.
+*/
+template<typename T>
+const T* findContiguous(const T* first, const T* last, const T& value) noexcept
+{
+    constexpr std::size_t block = 16;
+    const T v = value;                                  // Local copy; value could alias the range
+
+    while (static_cast<std::size_t>(last - first) >= block)
+    {
+        unsigned hits = 0;
+
+        for (std::size_t i = 0; i < block; ++i)
+        {
+            hits |= static_cast<unsigned>(first[i] == v);   // No branch per element
+        }
+
+        if (hits != 0)
+        {
+            return std::find(first, first + block, v);
+        }
+
+        first += block;
+    }
+
+    return std::find(first, last, v);
+}
+
+template<typename C>
+concept ContiguousArithmetic = std::contiguous_iterator<decltype(std::cbegin(std::declval<C&>()))>
+                               && std::is_arithmetic_v<typename C::value_type>;
+
+template<typename C, typename V>
+    requires ContiguousArithmetic<C> && std::same_as<V, typename C::value_type>
+void findAndInsert(C& container, const V& targetVal, const V& insertVal)
+{
+    using std::cbegin;
+    using std::cend;
+
+    auto first = std::to_address(cbegin(container)), last = std::to_address(cend(container));
+    auto found = findContiguous(first, last, targetVal);
+
+    container.insert(cbegin(container) + (found - first), insertVal);
+}
+
+template<typename Policy, typename C, typename V>
+    requires std::is_execution_policy_v<std::remove_cvref_t<Policy>>
+void findAndInsert(Policy&& policy, C& container, const V& targetVal, const V& insertVal)
+{
+    using std::cbegin;
+    using std::cend;
+
+    auto it = std::find(std::forward<Policy>(policy), cbegin(container), cend(container), targetVal);
+
+    container.insert(it, insertVal);
+}
+
+struct SortedRange { };
+
+inline constexpr SortedRange sortedRange { };
+
+template<typename C, typename V>
+void findAndInsert(SortedRange, C& container, const V& targetVal, const V& insertVal)
+{
+    using std::cbegin;
+    using std::cend;
+
+    auto it = std::lower_bound(cbegin(container), cend(container), targetVal);
+
+    if (it != cend(container) && !(*it == targetVal))
+    {
+        it = cend(container);                           // Not present: same as std::find's result
+    }
+
+    container.insert(it, insertVal);
+}
+
+findAndInsert(values, 1983, 1998);                          // Blocked search, since values is a std::vector<int>
+findAndInsert(std::execution::par_unseq, values, 1983, 1998);
+findAndInsert(sortedRange, values, 1983, 1998);             // values must be sorted
+
+
+/**
+ * Many Insertions at Once:
+ * k calls to findAndInsert cost k searches and k shifts, O(k * n). findAndInsertMany takes all the (targetVal,
+ * insertVal) pairs at once and does two passes over the container: one to find the first occurrence of every target
+ * (a hash lookup per element), and one that grows the container by k and moves each element straight to its final
+ * position, back to front, writing the inserted values into the gaps. That's O(n + k log k).
+ *
+ * Positions are those of the targets in the container as it was on entry, and values inserted at the same position
+ * keep the order of their requests, which is the result the sequential calls produce as long as no insertVal is also a
+ * later targetVal. The container needs resize and operator[], as std::vector and std::deque have.
+*/
+template<typename C, typename Requests>
+    requires requires(C& c, std::size_t n) { c.resize(n); c[n]; }
+void findAndInsertMany(C& container, const Requests& requests)
+{
+    constexpr auto notFound = static_cast<std::size_t>(-1);
+    const auto size = container.size();
+
+    std::unordered_map<typename C::value_type, std::size_t> firstIndex;
+
+    for (const auto& [target, value] : requests)
+    {
+        firstIndex.emplace(target, notFound);
+    }
+
+    for (std::size_t i = 0, unresolved = firstIndex.size(); i < size && unresolved != 0; ++i)
+    {
+        if (auto it = firstIndex.find(container[i]); it != firstIndex.end() && it->second == notFound)
+        {
+            it->second = i;
+            --unresolved;
+        }
+    }
+
+    // (position, request) pairs in position order; stable, so equal positions keep request order
+    std::vector<std::pair<std::size_t, const typename C::value_type*>> inserts;
+
+    for (const auto& [target, value] : requests)
+    {
+        auto position = firstIndex[target];
+        inserts.emplace_back(position == notFound ? size : position, &value);
+    }
+
+    std::stable_sort(inserts.begin(), inserts.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    container.resize(size + inserts.size());
+
+    auto read = size, write = size + inserts.size();
+
+    for (auto request = inserts.rbegin(); request != inserts.rend(); ++request)
+    {
+        while (read > request->first)
+        {
+            container[--write] = std::move(container[--read]);
+        }
+
+        container[--write] = *request->second;
+    }
+}
+
+std::vector<std::pair<int, int>> requests { { 1983, 1998 }, { 2011, 2014 }, { 1983, 1999 } };
+
+findAndInsertMany(values, requests);                        // 1998, 1999, 1983, ..., 2014, 2011, ...
+
+
+/**
+ * Benchmarks:
+ * The vector holds 0, 1, 2, ..., so it's sorted, and the target sits 90% of the way through: the search visits most
+ * of the elements and the shift moves the last tenth. Each case inserts and then erases the value again, so the vector
+ * doesn't grow. The registered cases use 1,000 and 1,000,000 elements (see Item 24 for registerBenchmark).
+ *
+ * reportFindAndInsert sweeps sizes from 1,000 to 100,000,000 elements and prints the average time per call for each
+ * search strategy, then compares 64 findAndInsert calls with one findAndInsertMany of the same 64 requests. Run it on
+ * a machine with several cores to see par_unseq do anything; on one core it's std::find plus overhead.
+*/
+constexpr std::size_t batchRequests = 64;
+
+inline std::vector<int> iotaVector(std::size_t n)
+{
+    std::vector<int> v(n);
+    std::iota(v.begin(), v.end(), 0);
+
+    return v;
+}
+
+template<typename Insert>
+auto insertAndErase(std::vector<int>& v, Insert insert)
+{
+    const auto target = static_cast<int>(v.size() / 10 * 9);
+
+    insert(v, target);
+    v.erase(std::find(v.begin() + target, v.end(), -1));    // The inserted value (-1) is right before target
+
+    return v.size();
+}
+
+inline void reportFindAndInsert()
+{
+    using namespace std::chrono;
+
+    for (std::size_t n = 1'000; n <= 100'000'000; n *= 10)
+    {
+        auto v = iotaVector(n);
+        const auto repetitions = std::max<std::size_t>(1, 100'000'000 / n);
+
+        auto time = [&](const char* label, auto insert)
+        {
+            auto start = steady_clock::now();
+
+            for (std::size_t i = 0; i < repetitions; ++i)
+            {
+                insertAndErase(v, insert);
+            }
+
+            auto perCall = duration_cast<nanoseconds>(steady_clock::now() - start) / repetitions;
+            std::cout << n << " elements, " << label << ": " << perCall.count() << " ns per call\n";
+        };
+
+        time("std::find", [](auto& c, int t) { c.insert(std::find(c.cbegin(), c.cend(), t), -1); });
+        time("findContiguous", [](auto& c, int t) { findAndInsert(c, t, -1); });
+        time("par_unseq", [](auto& c, int t) { findAndInsert(std::execution::par_unseq, c, t, -1); });
+        time("sortedRange", [](auto& c, int t) { findAndInsert(sortedRange, c, t, -1); });
+
+        std::vector<std::pair<int, int>> batch;
+
+        for (std::size_t i = 0; i < batchRequests; ++i)
+        {
+            batch.emplace_back(static_cast<int>(n / batchRequests * i), -1);
+        }
+
+        auto timeBatch = [&](const char* label, auto insertAll)
+        {
+            const auto batchRepetitions = std::max<std::size_t>(1, repetitions / batchRequests);
+            nanoseconds total { 0 };
+
+            for (std::size_t i = 0; i < batchRepetitions; ++i)
+            {
+                auto copy = v;
+                auto start = steady_clock::now();
+                insertAll(copy);
+                total += duration_cast<nanoseconds>(steady_clock::now() - start);
+            }
+
+            std::cout << n << " elements, " << label << ": " << (total / batchRepetitions).count() << " ns per batch\n";
+        };
+
+        timeBatch("64 x findAndInsert", [&](auto& c)
+        {
+            for (const auto& [target, value] : batch)
+            {
+                findAndInsert(c, target, value);
+            }
+        });
+        timeBatch("findAndInsertMany", [&](auto& c) { findAndInsertMany(c, batch); });
+    }
+}
+
+inline const bool item13Registered = []
+{
+    for (std::size_t n : { 1'000, 1'000'000 })
+    {
+        const auto suffix = ", " + std::to_string(n) + " elements";
+
+        registerBenchmark("Item 13/std::find" + suffix, [v = iotaVector(n)]() mutable
+        {
+            return insertAndErase(v, [](auto& c, int t) { c.insert(std::find(c.cbegin(), c.cend(), t), -1); });
+        }, n >= 1'000'000 ? std::optional(batchBenchmark) : std::nullopt);
+
+        registerBenchmark("Item 13/findContiguous" + suffix, [v = iotaVector(n)]() mutable
+        {
+            return insertAndErase(v, [](auto& c, int t) { findAndInsert(c, t, -1); });
+        }, n >= 1'000'000 ? std::optional(batchBenchmark) : std::nullopt);
+
+        registerBenchmark("Item 13/par_unseq" + suffix, [v = iotaVector(n)]() mutable
+        {
+            return insertAndErase(v, [](auto& c, int t) { findAndInsert(std::execution::par_unseq, c, t, -1); });
+        }, n >= 1'000'000 ? std::optional(batchBenchmark) : std::nullopt);
+
+        registerBenchmark("Item 13/sortedRange" + suffix, [v = iotaVector(n)]() mutable
+        {
+            return insertAndErase(v, [](auto& c, int t) { findAndInsert(sortedRange, c, t, -1); });
+        }, n >= 1'000'000 ? std::optional(batchBenchmark) : std::nullopt);
+    }
+
+    return true;
+}();
+
+reportFindAndInsert();
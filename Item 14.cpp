@@ -1,3 +1,10 @@
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 /**
  * Declare functions noexcept if they won't emit exceptions.
@@ -101,4 +108,224 @@ struct pair
  * Compiler Assistance:
  * Compilers typically do not help in identifying inconsistencies between function implementations and their exception
  * specifications.
-*/
\ No newline at end of file
+*/
+
+
+/**
+ * A Vector That Relocates When It Can:
+ * When vw reallocates, it has to get every element into the new buffer, and std::vector decides how with
+ * std::move_if_noexcept: move if the move can't throw (or there's no copy), otherwise copy, so a failure midway leaves
+ * the old buffer intact. For many types that's more work than needed. If a type is trivially relocatable (see Item 29),
+ * "move into the new buffer, destroy the old element" has exactly the effect of copying its bytes, and one memcpy moves
+ * the whole buffer.
+ *
+ * RelocatingVector makes the three-way choice at compile time:
+ *
+ * - Trivially relocatable: memcpy the buffer; no constructors or destructors run.
+ *
+ * - noexcept move (or no copy constructor at all): move each element, then destroy the originals, as std::vector does.
+ *   A move-only type whose move can throw gets only the basic guarantee: if a move throws, nothing leaks, but the
+ *   elements already moved from are left in their moved-from state.
+ *
+ * - Potentially-throwing move and a copy constructor: copy each element. If a copy throws, the copies made so far are
+ *   destroyed and the vector is unchanged: the strong guarantee push_back has had since C++98.
+*/
+template<typename T>
+class RelocatingVector
+{
+    public:
+        RelocatingVector() noexcept = default;
+
+        // Move-only to keep this example short; copying would go through the same element-wise paths
+        RelocatingVector(const RelocatingVector&) = delete;
+        RelocatingVector& operator=(const RelocatingVector&) = delete;
+
+        RelocatingVector(RelocatingVector&& rhs) noexcept
+            : elements(std::exchange(rhs.elements, nullptr)),
+              count(std::exchange(rhs.count, 0)),
+              cap(std::exchange(rhs.cap, 0)) { }
+
+        ~RelocatingVector()
+        {
+            std::destroy_n(elements, count);
+            deallocate(elements);
+        }
+
+        template<typename... Ts>
+        T& emplace_back(Ts&&... params)
+        {
+            if (count == cap)
+            {
+                // Build the new element in the new buffer first: params may refer to an existing element
+                auto newCap = cap ? 2 * cap : 4;
+                auto newElements = allocate(newCap);
+
+                try
+                {
+                    ::new (static_cast<void*>(newElements + count)) T(std::forward<Ts>(params)...);
+                }
+                catch (...)
+                {
+                    deallocate(newElements);
+                    throw;
+                }
+
+                relocateInto(newElements);      // On a throw, cleans up newElements; see relocateInto for the guarantee
+                deallocate(std::exchange(elements, newElements));
+                cap = newCap;
+            }
+            else
+            {
+                ::new (static_cast<void*>(elements + count)) T(std::forward<Ts>(params)...);
+            }
+
+            return elements[count++];
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        T& operator[](std::size_t i) noexcept { return elements[i]; }
+        const T& operator[](std::size_t i) const noexcept { return elements[i]; }
+
+        std::size_t size() const noexcept { return count; }
+        std::size_t capacity() const noexcept { return cap; }
+
+        T* begin() noexcept { return elements; }
+        T* end() noexcept { return elements + count; }
+
+    private:
+        static constexpr bool relocateWithMemcpy = isTriviallyRelocatable<T>;
+        static constexpr bool relocateWithMove = std::is_nothrow_move_constructible_v<T>
+                                                 || !std::is_copy_constructible_v<T>;
+
+        // Move the count existing elements into dst, leaving elements without live objects
+        void relocateInto(T* dst)
+        {
+            if constexpr (relocateWithMemcpy)
+            {
+                if (count)
+                {
+                    std::memcpy(static_cast<void*>(dst), static_cast<const void*>(elements), count * sizeof(T));
+                }
+            }
+            else
+            {
+                // Both algorithms destroy what they built if an element throws. Only a throwing move (possible just
+                // for move-only types) leaves the originals changed: basic guarantee there, strong for the copy path
+                try
+                {
+                    if constexpr (relocateWithMove)
+                    {
+                        std::uninitialized_move_n(elements, count, dst);
+                    }
+                    else
+                    {
+                        std::uninitialized_copy_n(elements, count, dst);
+                    }
+                }
+                catch (...)
+                {
+                    std::destroy_at(dst + count);                       // The newly emplaced element
+                    deallocate(dst);
+                    throw;
+                }
+
+                std::destroy_n(elements, count);
+            }
+        }
+
+        static T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t { alignof(T) }));
+        }
+
+        static void deallocate(T* p) noexcept
+        {
+            ::operator delete(p, std::align_val_t { alignof(T) });
+        }
+
+        T* elements { nullptr };
+        std::size_t count { 0 };
+        std::size_t cap { 0 };
+};
+
+
+/**
+ * Benchmarks:
+ * Each case appends growthCount Widgets to an empty vector without reserving, so it includes every reallocation (see
+ * Item 24 for registerBenchmark). The four Widgets hold the same data and differ only in their move operations:
+ *
+ * - RelocatableWidget has noexcept moves and opts in to IsTriviallyRelocatable: std::vector moves it, RelocatingVector
+ *   copies raw bytes.
+ *
+ * - NoexceptWidget has noexcept moves: both vectors move it.
+ *
+ * - ThrowingMoveWidget's move constructor isn't noexcept: both vectors copy it on growth.
+ *
+ * - CopyOnlyWidget declares only copy operations, so rvalues copy too: both vectors copy it on growth.
+*/
+struct RelocatableWidget
+{
+    std::vector<int> data;
+};
+
+template<>
+struct IsTriviallyRelocatable<RelocatableWidget> : std::true_type { };
+
+struct NoexceptWidget
+{
+    std::vector<int> data;
+};
+
+struct ThrowingMoveWidget
+{
+    ThrowingMoveWidget() = default;
+    ThrowingMoveWidget(const ThrowingMoveWidget&) = default;
+    ThrowingMoveWidget(ThrowingMoveWidget&& rhs) : data(std::move(rhs.data)) { }       // Not declared noexcept
+
+    std::vector<int> data;
+};
+
+struct CopyOnlyWidget
+{
+    CopyOnlyWidget() = default;
+    CopyOnlyWidget(const CopyOnlyWidget&) = default;                // Suppresses the implicit moves; see Item 17
+
+    std::vector<int> data;
+};
+
+constexpr std::size_t growthCount = 10'000;
+
+template<typename Vector, typename Widget>
+std::size_t growVector()
+{
+    Vector vw;
+    Widget w;
+    w.data.assign(16, 1);
+
+    for (std::size_t i = 0; i < growthCount; ++i)
+    {
+        vw.push_back(w);
+    }
+
+    return vw.size();
+}
+
+template<typename Widget>
+void registerGrowthBenchmarks(const std::string& name)
+{
+    registerBenchmark("Item 14/std::vector growth, " + name, growVector<std::vector<Widget>, Widget>, batchBenchmark);
+    registerBenchmark("Item 14/RelocatingVector growth, " + name, growVector<RelocatingVector<Widget>, Widget>,
+                      batchBenchmark);
+}
+
+inline const bool item14Registered = []
+{
+    registerGrowthBenchmarks<RelocatableWidget>("RelocatableWidget");
+    registerGrowthBenchmarks<NoexceptWidget>("NoexceptWidget");
+    registerGrowthBenchmarks<ThrowingMoveWidget>("ThrowingMoveWidget");
+    registerGrowthBenchmarks<CopyOnlyWidget>("CopyOnlyWidget");
+
+    return true;
+}();
@@ -1,4 +1,10 @@
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <type_traits>
+#include <vector>
 /**
  * Use constexpr whenever possible.
  *
@@ -134,4 +140,158 @@ constexpr auto reflectedMid = reflection(mid);     // ReflectedMid's value is (-
  *
  * Declaring something constexpr implies a commitment to maintaining its constant expression status, as changing it later
  * can break client code.
-*/
\ No newline at end of file
+*/
+
+
+/**
+ * Compile-Time Lookup Tables:
+ * pow(3, num) sizing an array is a single compile-time value. The same mechanism can fill whole tables: makeTable calls
+ * a generator for every index from 0 to N - 1 and returns the results as a std::array. The generator can be any
+ * constexpr callable, including a lambda (lambdas are implicitly constexpr since C++17).
+ *
+ * makeTable is consteval rather than constexpr. A constexpr function may quietly run at run time when its result isn't
+ * required to be a constant; a consteval function can't be called at run time at all, so every table is guaranteed to
+ * be computed by the compiler and stored in the binary's read-only data. A generator that can't be evaluated at
+ * compile time, e.g. one that allocates or reads a global, is a compile error instead of a start-up cost.
+*/
+template<std::size_t N, typename Generator>
+consteval auto makeTable(Generator generator)
+{
+    std::array<std::invoke_result_t<Generator, std::size_t>, N> table { };
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        table[i] = generator(i);
+    }
+
+    return table;
+}
+
+// 3^0 ... 3^15; 3^20 would overflow int, and overflow in a constant expression is a compile error
+inline constexpr auto powersOf3 = makeTable<16>([](std::size_t i) { return pow(3, static_cast<int>(i)); });
+
+static_assert(powersOf3[num] == pow(3, num));
+
+// CRC-32 (the reflected 0xEDB88320 polynomial used by zlib, PNG and Ethernet), one entry per byte value
+constexpr std::uint32_t crc32Entry(std::size_t byte) noexcept
+{
+    auto crc = static_cast<std::uint32_t>(byte);
+
+    for (int bit = 0; bit < 8; ++bit)
+    {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+    }
+
+    return crc;
+}
+
+inline constexpr auto crc32Table = makeTable<256>(crc32Entry);
+
+constexpr std::uint32_t crc32(std::span<const std::uint8_t> bytes) noexcept
+{
+    std::uint32_t crc = 0xFFFFFFFF;
+
+    for (auto byte : bytes)
+    {
+        crc = crc32Table[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+// The same algorithm, bit by bit: what the table saves at run time
+constexpr std::uint32_t crc32Bitwise(std::span<const std::uint8_t> bytes) noexcept
+{
+    std::uint32_t crc = 0xFFFFFFFF;
+
+    for (auto byte : bytes)
+    {
+        crc = crc32Entry((crc ^ byte) & 0xFF) ^ (crc >> 8);
+    }
+
+    return ~crc;
+}
+
+constexpr std::array<std::uint8_t, 9> crcCheckInput { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+static_assert(crc32(crcCheckInput) == 0xCBF43926);              // The standard CRC-32 check value
+
+// Centers of the cells of an 8x8 grid, and their reflections, from midpoint and reflection above
+constexpr std::size_t gridSize = 8;
+
+inline constexpr auto cellCenters = makeTable<gridSize * gridSize>([](std::size_t cell)
+{
+    auto column = static_cast<double>(cell % gridSize), row = static_cast<double>(cell / gridSize);
+
+    return midpoint(Point(column, row), Point(column + 1, row + 1));
+});
+
+inline constexpr auto reflectedCenters = makeTable<gridSize * gridSize>([](std::size_t cell)
+{
+    return reflection(cellCenters[cell]);
+});
+
+static_assert(cellCenters[9].xValue() == 1.5 && reflectedCenters[9].yValue() == -1.5);
+
+auto p = powersOf3[exponentFromInput()];            // Fine: indexing the table happens at run time
+auto t = makeTable<4>([n = exponentFromInput()](std::size_t i) { return n * i; });     // Error! not a constant
+
+
+/**
+ * Benchmarks:
+ * Each table against computing the same values at run time (see Item 24 for registerBenchmark). The indices and the
+ * 4 KB CRC input come from run-time data, so the compiler can't fold the computed versions either. It's the CRC that
+ * shows the difference: eight shift-and-xor steps per byte against one load. pow(3, e) is a short loop, and midpoint is
+ * two additions and two divisions, so a table only wins for them if the values are needed often and the table stays
+ * in cache.
+ *
+ * reportTableSizes prints what each table adds to the binary's read-only data. Tables that are only used in constant
+ * expressions take no space at all. For the real numbers in a build, look at the symbols: nm --size-sort -C, or size
+ * for the totals of each section.
+*/
+constexpr std::size_t crcBenchBytes = 4096;
+
+inline void reportTableSizes()
+{
+    std::cout << "powersOf3: " << sizeof(powersOf3) << " bytes\n"
+              << "crc32Table: " << sizeof(crc32Table) << " bytes\n"
+              << "cellCenters: " << sizeof(cellCenters) << " bytes\n"
+              << "reflectedCenters: " << sizeof(reflectedCenters) << " bytes\n";
+}
+
+inline const bool item15Registered = []
+{
+    static const auto crcInput = []
+    {
+        std::vector<std::uint8_t> bytes(crcBenchBytes);
+
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+        {
+            bytes[i] = static_cast<std::uint8_t>(i * 131 + 7);
+        }
+
+        return bytes;
+    }();
+
+    registerBenchmark("Item 15/pow, computed", [next = 0]() mutable { return pow(3, next++ % 16); });
+    registerBenchmark("Item 15/pow, table", [next = 0u]() mutable { return powersOf3[next++ % 16]; });
+
+    registerBenchmark("Item 15/crc32 4 KB, bitwise", [] { return crc32Bitwise(crcInput); });
+    registerBenchmark("Item 15/crc32 4 KB, table", [] { return crc32(crcInput); });
+
+    registerBenchmark("Item 15/cell center, computed", [next = std::size_t { 0 }]() mutable
+    {
+        auto cell = next++ % (gridSize * gridSize);
+        auto column = static_cast<double>(cell % gridSize), row = static_cast<double>(cell / gridSize);
+
+        return midpoint(Point(column, row), Point(column + 1, row + 1)).xValue();
+    });
+    registerBenchmark("Item 15/cell center, table", [next = std::size_t { 0 }]() mutable
+    {
+        return cellCenters[next++ % (gridSize * gridSize)].xValue();
+    });
+
+    return true;
+}();
+
+reportTableSizes();
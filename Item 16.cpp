@@ -1,5 +1,11 @@
+#include <array>
 #include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 /**
  * Make const member functions thread safe.
@@ -191,3 +197,321 @@ class Widget
         mutable int cachedValue;                       // no longer atomic
         mutable bool cacheValid{ false };              // no longer atomic
 };
+
+
+/**
+ * Publishing a Cached Value Once:
+ * The mutex versions are correct, but every call locks, even long after the cache is warm and nothing will ever be
+ * written again. Readers of a warm cache only need to know that the value exists and see it fully constructed, which is
+ * exactly what a single atomic pointer with acquire/release ordering provides:
+ *
+ * - The writer constructs the value, then stores its address with memory_order_release.
+ *
+ * - A reader loads the pointer with memory_order_acquire. If it's non-null, everything the writer did before the store
+ *   (constructing the value) is visible, so the reader can use it without taking any lock.
+ *
+ * Only a reader that finds the pointer null takes the mutex, checks again (another thread may have computed the value
+ * while it waited), and computes. This is double-checked locking, and unlike the pair of std::atomics in magicValue
+ * above, it's correct: there is one atomic, and the value it points to is complete before it's published.
+ *
+ * ---------------------------------------------------------------------------------------------------------------------
+ *
+ * Invalidation:
+ * Readers hold a plain reference to the published value, so invalidate can't destroy it on the spot. It unpublishes the
+ * value and retires it instead; retired values are destroyed by reclaim, which the owner calls at a point where no
+ * reader can still hold a reference (or by the destructor). The next get recomputes.
+ *
+ * std::call_once would give the same fast path for compute-once values, but a std::once_flag can't be reset, so it has
+ * no invalidation path.
+*/
+template<typename T>
+class LazyCached
+{
+    public:
+        LazyCached() = default;
+
+        // Holds a mutex, so not copyable or movable (see above)
+        LazyCached(const LazyCached&) = delete;
+        LazyCached& operator=(const LazyCached&) = delete;
+
+        ~LazyCached()
+        {
+            delete published.load(std::memory_order_relaxed);
+        }
+
+        template<typename Compute>
+        const T& get(Compute&& compute) const
+        {
+            // Fast path: no lock, no read-modify-write
+            if (auto p = published.load(std::memory_order_acquire))
+            {
+                return *p;
+            }
+
+            std::lock_guard<std::mutex> g { m };
+
+            // Checked again under the lock, hence "double-checked"
+            if (auto p = published.load(std::memory_order_relaxed))
+            {
+                return *p;
+            }
+
+            auto p = new T(std::forward<Compute>(compute)());
+            published.store(p, std::memory_order_release);
+
+            return *p;
+        }
+
+        void invalidate()
+        {
+            std::lock_guard<std::mutex> g { m };
+
+            if (auto p = published.exchange(nullptr, std::memory_order_acq_rel))
+            {
+                retired.emplace_back(p);
+            }
+        }
+
+        // Only when no reader can still hold a reference obtained before an invalidate
+        void reclaim()
+        {
+            std::lock_guard<std::mutex> g { m };
+            retired.clear();
+        }
+
+    private:
+        mutable std::atomic<const T*> published { nullptr };
+        mutable std::mutex m;                                   // Serializes computing and invalidating
+        std::vector<std::unique_ptr<const T>> retired;
+};
+
+
+/**
+ * Using LazyCached:
+ * Both examples from this Item become a single mutable member. roots still returns by value, as before, but making that
+ * copy no longer serializes callers.
+*/
+class Polynomial
+{
+    public:
+        using RootsType = std::vector<double>;
+
+        RootsType roots() const
+        {
+            return rootVals.get([this] { return computeRoots(); });
+        }
+
+        // E.g., after the coefficients change
+        void coefficientsChanged()
+        {
+            rootVals.invalidate();
+        }
+
+    private:
+        RootsType computeRoots() const;
+
+        mutable LazyCached<RootsType> rootVals;
+};
+
+
+class Widget
+{
+    public:
+        int magicValue() const
+        {
+            return cachedValue.get([] { return expensiveComputation1() + expensiveComputation2(); });
+        }
+
+    private:
+        mutable LazyCached<int> cachedValue;
+};
+
+
+/**
+ * Benchmarks:
+ * Read-heavy contention: the cache is warmed once, then 1 to 64 threads call magicValue on the same object (see Item 24
+ * for runConcurrently). With the mutex, every call is a lock and unlock on one shared cache line, so the time per batch
+ * grows with the thread count. With LazyCached, a warm call is an acquire load, which on x86 is an ordinary load, and the
+ * cache line stays shared in every core's cache.
+*/
+class MutexMagic
+{
+    public:
+        int magicValue() const
+        {
+            std::lock_guard<std::mutex> guard { m };
+
+            if (!cacheValid)
+            {
+                cachedValue = expensiveComputation1() + expensiveComputation2();
+                cacheValid = true;
+            }
+
+            return cachedValue;
+        }
+
+    private:
+        mutable std::mutex m;
+        mutable int cachedValue;
+        mutable bool cacheValid { false };
+};
+
+constexpr std::size_t readsPerThread = 100'000;
+
+inline const bool item16CacheRegistered = []
+{
+    static MutexMagic mutexWidget;
+    static Widget lazyWidget;
+
+    for (unsigned threads = 1; threads <= 64; threads *= 2)
+    {
+        registerBenchmark("Item 16/mutex magicValue, " + std::to_string(threads) + " threads", [threads]
+        {
+            return runConcurrently(threads, readsPerThread, [](unsigned, std::size_t)
+                                   { doNotOptimize(mutexWidget.magicValue()); });
+        }, batchBenchmark);
+
+        registerBenchmark("Item 16/LazyCached magicValue, " + std::to_string(threads) + " threads", [threads]
+        {
+            return runConcurrently(threads, readsPerThread, [](unsigned, std::size_t)
+                                   { doNotOptimize(lazyWidget.magicValue()); });
+        }, batchBenchmark);
+    }
+
+    return true;
+}();
+
+
+/**
+ * Contended Counters:
+ * Point::distanceFromOrigin is thread safe, but every call from every thread increments the same std::atomic. Each
+ * increment needs the cache line holding callCount in exclusive state, so with several cores calling it the line
+ * bounces between their caches and the increment, not the sqrt, sets the pace.
+ *
+ * ShardedCounter gives each thread its own slot to increment, padded to a full cache line so neighboring slots never
+ * share one (false sharing would bring the bouncing right back). Reading sums the slots. An increment is then an
+ * uncontended relaxed fetch_add; a read is proportional to the number of slots and sees a value that is exact once
+ * concurrent increments have finished, which is all a statistics counter needs.
+ *
+ * ---------------------------------------------------------------------------------------------------------------------
+ *
+ * Cost:
+ * With 64 slots of 64 bytes each, a ShardedCounter is 4 KB, so it pays off for a few heavily shared objects (or one
+ * counter shared by all Points), not as a member of millions of small ones. Threads are assigned slots round-robin, so
+ * with more threads than slots some threads share a slot; that's still correct, just contended again.
+*/
+class ShardedCounter
+{
+    public:
+        static constexpr std::size_t slotCount = 64;
+
+        void increment() noexcept
+        {
+            slots[slotIndex()].value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ShardedCounter& operator++() noexcept
+        {
+            increment();
+
+            return *this;
+        }
+
+        unsigned long load() const noexcept
+        {
+            unsigned long total = 0;
+
+            for (const auto& slot : slots)
+            {
+                total += slot.value.load(std::memory_order_relaxed);
+            }
+
+            return total;
+        }
+
+    private:
+        // One cache line per slot (64 bytes on current x86 and most ARM cores)
+        struct alignas(64) Slot
+        {
+            std::atomic<unsigned long> value { 0 };
+        };
+
+        static std::size_t slotIndex() noexcept
+        {
+            static std::atomic<std::size_t> nextIndex { 0 };
+            thread_local std::size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % slotCount;
+
+            return index;
+        }
+
+        std::array<Slot, slotCount> slots;
+};
+
+
+// 2D point
+class Point
+{
+    public:
+        // ShardedCounter::increment is noexcept, too
+        double distanceFromOrigin() const noexcept
+        {
+            ++callCount;
+
+            return std::sqrt((x * x) + (y * y));
+        }
+
+        unsigned long calls() const noexcept
+        {
+            return callCount.load();
+        }
+
+    private:
+        mutable ShardedCounter callCount;
+        double x, y;
+};
+
+
+/**
+ * Benchmarks:
+ * Three counters, each incremented incrementsPerThread times by each of 1 to 64 threads (see Item 24 for
+ * runConcurrently):
+ *
+ * - A single std::atomic, true sharing: all threads write the same variable.
+ *
+ * - An array of std::atomics with one element per thread but no padding, false sharing: the threads write different
+ *   variables, but eight of them fit in one cache line, so the line bounces just the same.
+ *
+ * - ShardedCounter: different variables on different cache lines.
+ *
+ * The first two slow down as threads are added; the third should scale until threads outnumber cores.
+*/
+constexpr std::size_t incrementsPerThread = 1'000'000;
+
+inline const bool item16CounterRegistered = []
+{
+    static std::atomic<unsigned long> single { 0 };
+    static std::array<std::atomic<unsigned long>, 64> unpadded { };
+    static ShardedCounter sharded;
+
+    for (unsigned threads = 1; threads <= 64; threads *= 2)
+    {
+        registerBenchmark("Item 16/single atomic, " + std::to_string(threads) + " threads", [threads]
+        {
+            return runConcurrently(threads, incrementsPerThread, [](unsigned, std::size_t)
+                                   { single.fetch_add(1, std::memory_order_relaxed); });
+        }, batchBenchmark);
+
+        registerBenchmark("Item 16/unpadded per-thread atomics, " + std::to_string(threads) + " threads", [threads]
+        {
+            return runConcurrently(threads, incrementsPerThread, [](unsigned t, std::size_t)
+                                   { unpadded[t].fetch_add(1, std::memory_order_relaxed); });
+        }, batchBenchmark);
+
+        registerBenchmark("Item 16/ShardedCounter, " + std::to_string(threads) + " threads", [threads]
+        {
+            return runConcurrently(threads, incrementsPerThread, [](unsigned, std::size_t) { sharded.increment(); });
+        }, batchBenchmark);
+    }
+
+    return true;
+}();
@@ -1,4 +1,10 @@
+#include <cstdint>
+#include <iostream>
 #include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <variant>
 /**
  * Use std::unique_ptr for exclusive-ownership resource management.
  *
@@ -141,3 +147,227 @@ std::unique_ptr<Investment, void (*)(Investment*)> makeInvestment(Ts&&... params
 */
 // Converts std::unique_ptr to std::shared_ptr
 std::shared_ptr<Investment> sp = makeInvestment( arguments );
+
+
+/**
+ * Pooled Investments and a Devirtualized Deleter:
+ * delInvmt costs a heap allocation per investment, and its delete goes through Investment's virtual destructor. Both
+ * can go without giving up a std::unique_ptr<Investment> handle:
+ *
+ * - Each concrete type is allocated from a pool keyed by its size and alignment, FixedSizePool from Item 21. Nothing is
+ *   returned to the general-purpose heap; a block goes back on its pool's free list.
+ *
+ * - Investment records which concrete type it is in a one-byte Kind, set by the derived class constructors.
+ *   PooledInvestmentDeleter switches on it and calls the concrete destructor with a qualified name, as in
+ *   p->Stock::~Stock(), which is never a virtual call, before returning the block to that type's pool. The deleter
+ *   has no state, so a PooledInvestment is the size of an Investment*.
+ *
+ * The virtual destructor is kept so the hierarchy still works with plain delete and std::shared_ptr. It just isn't
+ * what PooledInvestmentDeleter uses.
+*/
+class Investment
+{
+    public:
+        enum class Kind : std::uint8_t { stock, bond, realEstate };
+
+        virtual ~Investment() = default;
+
+        Kind kind() const noexcept { return k; }
+
+    protected:
+        explicit Investment(Kind k) noexcept : k(k) { }
+
+    private:
+        Kind k;
+};
+
+class Stock final: public Investment
+{
+    public:
+        Stock() noexcept : Investment(Kind::stock) { }
+
+    private:
+        double shares = 0, price = 0;
+};
+
+class Bond final: public Investment
+{
+    public:
+        Bond() noexcept : Investment(Kind::bond) { }
+
+    private:
+        double principal = 0, rate = 0;
+        int years = 0;
+};
+
+class RealEstate final: public Investment
+{
+    public:
+        RealEstate() : Investment(Kind::realEstate) { }
+
+    private:
+        std::string address;
+        double value = 0;
+};
+
+template<typename T>
+auto& poolFor() noexcept
+{
+    return FixedSizePool<sizeof(T), alignof(T)>::instance();
+}
+
+struct PooledInvestmentDeleter
+{
+    template<typename T>
+    static void destroy(Investment* pInvestment) noexcept
+    {
+        auto p = static_cast<T*>(pInvestment);
+
+        p->T::~T();                         // Qualified call: no virtual dispatch
+        poolFor<T>().deallocate(p);
+    }
+
+    void operator()(Investment* pInvestment) const noexcept
+    {
+        switch (pInvestment->kind())
+        {
+            case Investment::Kind::stock:       destroy<Stock>(pInvestment);       break;
+            case Investment::Kind::bond:        destroy<Bond>(pInvestment);        break;
+            case Investment::Kind::realEstate:  destroy<RealEstate>(pInvestment);  break;
+        }
+    }
+};
+
+using PooledInvestment = std::unique_ptr<Investment, PooledInvestmentDeleter>;
+
+template<typename T, typename... Ts>
+PooledInvestment makePooledInvestment(Ts&&... params)
+{
+    auto& pool = poolFor<T>();
+    auto raw = pool.allocate();
+
+    try
+    {
+        return PooledInvestment(::new (raw) T(std::forward<Ts>(params)...));
+    }
+    catch (...)
+    {
+        pool.deallocate(raw);               // T's ctor threw; the block goes straight back
+        throw;
+    }
+}
+
+// The runtime choice makeInvestment makes, with the conditions spelled out as a Kind
+inline PooledInvestment makePooledInvestment(Investment::Kind kind)
+{
+    switch (kind)
+    {
+        case Investment::Kind::stock:       return makePooledInvestment<Stock>();
+        case Investment::Kind::bond:        return makePooledInvestment<Bond>();
+        case Investment::Kind::realEstate:
+        default:                            return makePooledInvestment<RealEstate>();
+    }
+}
+
+static_assert(sizeof(PooledInvestment) == sizeof(Investment*));
+
+
+/**
+ * Value Semantics with std::variant:
+ * When the set of investment types is closed, a std::variant<Stock, Bond, RealEstate> needs no handle at all: the
+ * object lives inside the variant, construction and destruction never touch the heap, and std::visit dispatches on
+ * the stored index instead of a vtable. The costs are that the variant is as big as its largest alternative, and that
+ * adding a new kind of investment means changing the variant, which the class hierarchy avoids.
+*/
+using InvestmentValue = std::variant<Stock, Bond, RealEstate>;
+
+inline InvestmentValue makeInvestmentValue(Investment::Kind kind)
+{
+    switch (kind)
+    {
+        case Investment::Kind::stock:       return Stock();
+        case Investment::Kind::bond:        return Bond();
+        case Investment::Kind::realEstate:
+        default:                            return RealEstate();
+    }
+}
+
+auto value = makeInvestmentValue(Investment::Kind::bond);
+std::visit([](const auto& investment) { /* ... */ }, value);             // No virtual call
+
+
+/**
+ * Benchmarks:
+ * Each case creates and destroys one investment, cycling through the three kinds so neither the allocator nor the
+ * branch predictor sees only one size (see Item 24 for registerBenchmark). None of the deleters log here, so the cases
+ * compare only allocation and destruction. reportHandleSizes prints what each style costs per handle: the stateless
+ * deleters add nothing to a pointer, the function pointer adds a pointer, and the variant is the largest alternative
+ * plus its index.
+*/
+inline void deleteInvestment(Investment* pInvestment)
+{
+    delete pInvestment;
+}
+
+inline auto deleteInvestmentLambda = [](Investment* pInvestment) { delete pInvestment; };
+
+template<typename Ptr, typename... Deleter>
+Ptr makeHeapInvestment(Investment::Kind kind, Deleter... del)
+{
+    switch (kind)
+    {
+        case Investment::Kind::stock:       return Ptr(new Stock, del...);
+        case Investment::Kind::bond:        return Ptr(new Bond, del...);
+        case Investment::Kind::realEstate:
+        default:                            return Ptr(new RealEstate, del...);
+    }
+}
+
+inline Investment::Kind nextKind() noexcept
+{
+    static unsigned next = 0;
+
+    return static_cast<Investment::Kind>(next++ % 3);
+}
+
+inline void reportHandleSizes()
+{
+    std::cout << "unique_ptr<Investment>: " << sizeof(std::unique_ptr<Investment>) << " bytes\n"
+              << "unique_ptr with stateless lambda deleter: "
+              << sizeof(std::unique_ptr<Investment, decltype(deleteInvestmentLambda)>) << " bytes\n"
+              << "unique_ptr with function pointer deleter: "
+              << sizeof(std::unique_ptr<Investment, void (*)(Investment*)>) << " bytes\n"
+              << "PooledInvestment: " << sizeof(PooledInvestment) << " bytes\n"
+              << "variant<Stock, Bond, RealEstate>: " << sizeof(InvestmentValue) << " bytes\n";
+}
+
+inline const bool item18Registered = []
+{
+    registerBenchmark("Item 18/unique_ptr, default delete", []
+    {
+        return makeHeapInvestment<std::unique_ptr<Investment>>(nextKind()) != nullptr;
+    });
+
+    registerBenchmark("Item 18/unique_ptr, stateless lambda deleter", []
+    {
+        using Ptr = std::unique_ptr<Investment, decltype(deleteInvestmentLambda)>;
+
+        return makeHeapInvestment<Ptr>(nextKind(), deleteInvestmentLambda) != nullptr;
+    });
+
+    registerBenchmark("Item 18/unique_ptr, function pointer deleter", []
+    {
+        using Ptr = std::unique_ptr<Investment, void (*)(Investment*)>;
+
+        return makeHeapInvestment<Ptr>(nextKind(), &deleteInvestment) != nullptr;
+    });
+
+    registerBenchmark("Item 18/PooledInvestment", [] { return makePooledInvestment(nextKind()) != nullptr; });
+
+    registerBenchmark("Item 18/variant<Stock, Bond, RealEstate>",
+                      [] { return makeInvestmentValue(nextKind()).index(); });
+
+    return true;
+}();
+
+reportHandleSizes();
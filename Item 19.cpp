@@ -1,4 +1,11 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
 #include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 /**
  * Use std::shared_ptr for shared-ownership resource management.
@@ -152,3 +159,263 @@ class Widget: public std::enable_shared_from_this<Widget>
 */
 
 
+/**
+ * Intrusive Reference Counting:
+ * process pays twice for shared_from_this: the call locks the hidden std::weak_ptr (a compare-and-swap loop on the
+ * control block's count), and the std::shared_ptr it pushes is two pointers wide. The control block itself is an
+ * extra 16 bytes even with std::make_shared, or a separate allocation with std::shared_ptr(new Widget).
+ *
+ * An intrusive count lives in the object instead. RefCounted<Derived> embeds it, and IntrusivePtr<T> is a single
+ * pointer that adds and releases references on it:
+ *
+ * - Making a handle from this is always safe, because there's only ever one count per object. There's no control
+ *   block that could be duplicated and no enable_shared_from_this to inherit from: process just pushes
+ *   IntrusivePtr(this).
+ *
+ * - Sharing::singleThread swaps the std::atomic for a plain integer, for objects that never leave one thread. Copies
+ *   then cost an ordinary increment.
+ *
+ * - The last release deletes through Derived, so the hierarchy needs no virtual destructor.
+ *
+ * What's given up is std::weak_ptr (there's no separate block to outlive the object), custom deleters, and the ability
+ * to share objects of types that weren't written for it.
+*/
+enum class Sharing { threads, singleThread };
+
+template<typename T>
+class IntrusivePtr;
+
+template<typename Derived, Sharing S = Sharing::threads>
+class RefCounted
+{
+    public:
+        RefCounted(const RefCounted&) noexcept { }                  // A copy is a new object with no owners yet
+        RefCounted& operator=(const RefCounted&) noexcept { return *this; }
+
+    protected:
+        RefCounted() noexcept = default;
+        ~RefCounted() = default;
+
+    private:
+        template<typename T>
+        friend class IntrusivePtr;
+
+        void addRef() const noexcept
+        {
+            if constexpr (S == Sharing::threads)
+            {
+                refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                ++refs;
+            }
+        }
+
+        void releaseRef() const noexcept
+        {
+            if constexpr (S == Sharing::threads)
+            {
+                if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete static_cast<const Derived*>(this);
+                }
+            }
+            else if (--refs == 0)
+            {
+                delete static_cast<const Derived*>(this);
+            }
+        }
+
+        using Count = std::conditional_t<S == Sharing::threads, std::atomic<std::uint32_t>, std::uint32_t>;
+
+        mutable Count refs { 0 };
+};
+
+template<typename T>
+class IntrusivePtr
+{
+    public:
+        IntrusivePtr() noexcept = default;
+
+        // Adds a reference, so this can be called with this, or with any other pointer to a live T
+        explicit IntrusivePtr(T* p) noexcept : p(p)
+        {
+            if (p)
+            {
+                p->addRef();
+            }
+        }
+
+        IntrusivePtr(const IntrusivePtr& rhs) noexcept : IntrusivePtr(rhs.p) { }
+        IntrusivePtr(IntrusivePtr&& rhs) noexcept : p(std::exchange(rhs.p, nullptr)) { }
+
+        // By value: covers copy and move assignment, and self-assignment
+        IntrusivePtr& operator=(IntrusivePtr rhs) noexcept
+        {
+            std::swap(p, rhs.p);
+
+            return *this;
+        }
+
+        ~IntrusivePtr()
+        {
+            if (p)
+            {
+                p->releaseRef();
+            }
+        }
+
+        T* get() const noexcept { return p; }
+        T& operator*() const noexcept { return *p; }
+        T* operator->() const noexcept { return p; }
+        explicit operator bool() const noexcept { return p != nullptr; }
+
+    private:
+        T* p = nullptr;
+};
+
+static_assert(sizeof(IntrusivePtr<int>) == sizeof(int*));
+
+class IntrusiveWidget: public RefCounted<IntrusiveWidget>
+{
+    public:
+        // Factory function that perfect-forwards args to a private ctor; the only way to make an IntrusiveWidget
+        template<typename... Ts>
+        static IntrusivePtr<IntrusiveWidget> create(Ts&&... params)
+        {
+            return IntrusivePtr<IntrusiveWidget>(new IntrusiveWidget(std::forward<Ts>(params)...));
+        }
+
+        void process()
+        {
+            // Process the Widget
+
+            processedWidgets.emplace_back(this);                    // No shared_from_this needed
+        }
+
+    private:
+        IntrusiveWidget() = default;
+
+        std::vector<IntrusivePtr<IntrusiveWidget>> processedWidgets;
+};
+
+
+/**
+ * Benchmarks:
+ * reportMemoryPerObject prints the bytes allocated per object for each way of creating it, measured through an
+ * allocator that records its requests (std::allocate_shared, and the allocator argument of the std::shared_ptr
+ * constructor, which is used for the control block), next to the size of each handle.
+ *
+ * The throughput cases push a handle to one shared widget onto the thread's own processedWidgets and pop it again,
+ * handleOpsPerThread times on each of 1, 8 and 32 threads (see Item 24 for runConcurrently). That's what process does:
+ * shared_from_this and a std::shared_ptr copy, against IntrusivePtr(this). All threads hit the same count, so with
+ * several cores both designs are limited by that cache line; the intrusive one does one atomic add per push instead of
+ * a compare-and-swap loop. The single-threaded mode only makes sense, and is only measured, on one thread.
+*/
+inline std::size_t bytesRequested = 0;
+
+template<typename T>
+struct RecordingAllocator
+{
+    using value_type = T;
+
+    RecordingAllocator() noexcept = default;
+
+    template<typename U>
+    RecordingAllocator(const RecordingAllocator<U>&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        bytesRequested += n * sizeof(T);
+
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>().deallocate(p, n); }
+
+    template<typename U>
+    bool operator==(const RecordingAllocator<U>&) const noexcept { return true; }
+};
+
+class SharedWidget: public std::enable_shared_from_this<SharedWidget>
+{
+    private:
+        std::vector<std::shared_ptr<SharedWidget>> processedWidgets;
+};
+
+class SingleThreadWidget: public RefCounted<SingleThreadWidget, Sharing::singleThread>
+{
+    private:
+        std::vector<IntrusivePtr<SingleThreadWidget>> processedWidgets;
+};
+
+inline void reportMemoryPerObject()
+{
+    bytesRequested = 0;
+    auto made = std::allocate_shared<SharedWidget>(RecordingAllocator<SharedWidget>());
+    std::cout << "make_shared<Widget>: " << bytesRequested << " bytes per object, handle "
+              << sizeof(std::shared_ptr<SharedWidget>) << " bytes\n";
+
+    bytesRequested = sizeof(SharedWidget);
+    std::shared_ptr<SharedWidget> adopted(new SharedWidget, std::default_delete<SharedWidget>(),
+                                          RecordingAllocator<SharedWidget>());
+    std::cout << "shared_ptr(new Widget): " << bytesRequested << " bytes per object in two allocations, handle "
+              << sizeof(std::shared_ptr<SharedWidget>) << " bytes\n";
+
+    std::cout << "IntrusiveWidget::create: " << sizeof(IntrusiveWidget) << " bytes per object, handle "
+              << sizeof(IntrusivePtr<IntrusiveWidget>) << " bytes\n";
+}
+
+constexpr std::size_t handleOpsPerThread = 100'000;
+
+inline const bool item19Registered = []
+{
+    static const auto sharedWidget = std::make_shared<SharedWidget>();
+    static const auto intrusiveWidget = IntrusiveWidget::create();
+
+    for (unsigned threads : { 1u, 8u, 32u })
+    {
+        const auto suffix = ", " + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+
+        registerBenchmark("Item 19/push and pop shared_from_this" + suffix, [threads]
+        {
+            return runConcurrently(threads, handleOpsPerThread, [](unsigned, std::size_t)
+            {
+                thread_local std::vector<std::shared_ptr<SharedWidget>> processedWidgets;
+
+                processedWidgets.emplace_back(sharedWidget->shared_from_this());
+                processedWidgets.pop_back();
+            });
+        }, batchBenchmark);
+
+        registerBenchmark("Item 19/push and pop IntrusivePtr" + suffix, [threads]
+        {
+            return runConcurrently(threads, handleOpsPerThread, [](unsigned, std::size_t)
+            {
+                thread_local std::vector<IntrusivePtr<IntrusiveWidget>> processedWidgets;
+
+                processedWidgets.emplace_back(intrusiveWidget.get());
+                processedWidgets.pop_back();
+            });
+        }, batchBenchmark);
+    }
+
+    registerBenchmark("Item 19/push and pop IntrusivePtr, single-thread count", []
+    {
+        static const IntrusivePtr<SingleThreadWidget> widget(new SingleThreadWidget);
+        static std::vector<IntrusivePtr<SingleThreadWidget>> processedWidgets;
+
+        for (std::size_t i = 0; i < handleOpsPerThread; ++i)
+        {
+            processedWidgets.emplace_back(widget.get());
+            processedWidgets.pop_back();
+        }
+
+        return handleOpsPerThread;
+    }, batchBenchmark);
+
+    return true;
+}();
+
+reportMemoryPerObject();
@@ -1,5 +1,20 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 /**
  * Use std::weak_ptr for std::shared_ptr-like pointers that can dangle.
  *
@@ -94,6 +109,458 @@ std::shared_ptr<const Widget> fastLoadWidget(WidgetID id)
 }
 
 
+/**
+ * A Concurrent Cache:
+ * fastLoadWidget's cache is shared by every caller, so concurrent calls race on the unordered_map, and the map only
+ * grows: an expired std::weak_ptr is overwritten when its ID is requested again, never removed. SharedCache fixes both:
+ *
+ * - Sharding: IDs hash to one of several shards, each with its own std::shared_mutex, so threads looking up different
+ *   IDs rarely touch the same lock, and hits on the same shard proceed in parallel under a shared lock. The remaining
+ *   per-hit cost is the atomic increment inside lock(), which no cache of std::weak_ptrs can avoid.
+ *
+ * - Single flight: the first thread to miss on an ID installs a std::shared_future in the entry and calls the loader
+ *   outside the lock. Threads that miss on the same ID meanwhile wait on that future instead of loading again. If the
+ *   loader throws, every waiter sees the exception and the next request retries.
+ *
+ * - Pruning: a background thread periodically sweeps one shard at a time and erases entries whose std::weak_ptr has
+ *   expired. It holds each shard's lock only for that shard's sweep.
+*/
+template<typename Key, typename T, std::size_t ShardCount = 16>
+class SharedCache
+{
+    public:
+        using Loader = std::function<std::shared_ptr<const T>(const Key&)>;
+
+        explicit SharedCache(Loader loader, std::chrono::milliseconds pruneInterval = std::chrono::seconds(1))
+            : load(std::move(loader)),
+              pruner([this, pruneInterval](std::stop_token stop) { pruneLoop(stop, pruneInterval); }) { }
+
+        std::shared_ptr<const T> get(const Key& id)
+        {
+            auto& shard = shardFor(id);
+
+            {
+                // Fast path: hit under a shared lock
+                std::shared_lock<std::shared_mutex> lk { shard.m };
+                auto it = shard.entries.find(id);
+
+                if (it != shard.entries.end())
+                {
+                    if (auto objPtr = it->second.cached.lock())
+                    {
+                        return objPtr;
+                    }
+                }
+            }
+
+            std::unique_lock<std::shared_mutex> lk { shard.m };
+            auto& entry = shard.entries[id];
+
+            // Another thread may have loaded it, or started loading it, since we released the shared lock
+            if (auto objPtr = entry.cached.lock())
+            {
+                return objPtr;
+            }
+
+            if (entry.inFlight.valid())
+            {
+                auto inFlight = entry.inFlight;     // Copy so the wait doesn't depend on the entry
+                lk.unlock();
+
+                return inFlight.get();              // Rethrows if the loading thread's loader threw
+            }
+
+            std::promise<std::shared_ptr<const T>> loaded;
+            entry.inFlight = loaded.get_future().share();
+            lk.unlock();
+
+            try
+            {
+                auto objPtr = load(id);
+                loaded.set_value(objPtr);
+
+                lk.lock();
+                auto& loadedEntry = shard.entries[id];          // Re-look up; rehashing may have moved it
+                loadedEntry.cached = objPtr;
+                loadedEntry.inFlight = { };
+
+                return objPtr;
+            }
+            catch (...)
+            {
+                loaded.set_exception(std::current_exception());
+
+                lk.lock();
+                shard.entries.erase(id);
+
+                throw;
+            }
+        }
+
+        std::size_t size() const
+        {
+            std::size_t total = 0;
+
+            for (const auto& shard : shards)
+            {
+                std::shared_lock<std::shared_mutex> lk { shard.m };
+                total += shard.entries.size();
+            }
+
+            return total;
+        }
+
+    private:
+        struct Entry
+        {
+            std::weak_ptr<const T> cached;
+            std::shared_future<std::shared_ptr<const T>> inFlight;       // Valid only while a load is running
+        };
+
+        // Padded so neighboring shards' mutexes don't share a cache line
+        struct alignas(64) Shard
+        {
+            mutable std::shared_mutex m;
+            std::unordered_map<Key, Entry> entries;
+        };
+
+        Shard& shardFor(const Key& id)
+        {
+            return shards[std::hash<Key>{ }(id) % ShardCount];
+        }
+
+        void pruneLoop(std::stop_token stop, std::chrono::milliseconds interval)
+        {
+            std::mutex m;
+            std::condition_variable_any cv;
+            std::unique_lock<std::mutex> lk { m };
+
+            // wait_for returns true only once stop is requested; see Item 39 for condvar-based waiting
+            while (!cv.wait_for(lk, stop, interval, [&stop] { return stop.stop_requested(); }))
+            {
+                for (auto& shard : shards)
+                {
+                    std::unique_lock<std::shared_mutex> shardLock { shard.m };
+                    std::erase_if(shard.entries, [](const auto& kv)
+                                  { return kv.second.cached.expired() && !kv.second.inFlight.valid(); });
+                }
+            }
+        }
+
+        Loader load;
+        std::array<Shard, ShardCount> shards;
+
+        // Declared last so it starts after the shards exist and is stopped and joined first (see Item 37)
+        std::jthread pruner;
+};
+
+std::shared_ptr<const Widget> fastLoadWidget(WidgetID id)
+{
+    static SharedCache<WidgetID, Widget> cache(loadWidget);
+
+    return cache.get(id);
+}
+
+
+/**
+ * Benchmarks:
+ * Each case runs lookupsPerThread lookups on each of 1 to 64 threads (see Item 24 for runConcurrently), so thread
+ * start-up is amortized over many lookups. Hits cycle through a fixed set of IDs whose objects are kept alive, because
+ * a cache of std::weak_ptrs only hits while someone else owns the object. Misses use a fresh ID every time, so each one
+ * goes through the loader and the exclusive lock, and the pruner has expired entries to sweep.
+*/
+using BenchWidgetID = std::uint64_t;
+
+struct BenchWidget
+{
+    BenchWidgetID id;
+};
+
+constexpr BenchWidgetID hotIDCount = 1024;
+constexpr std::size_t lookupsPerThread = 10'000;
+
+inline SharedCache<BenchWidgetID, BenchWidget> benchCache([](const BenchWidgetID& id)
+{
+    return std::make_shared<const BenchWidget>(id);
+});
+
+// 64 bits, so however long the benchmarks run, cold IDs never wrap around into the hot set
+inline std::atomic<BenchWidgetID> nextColdID { hotIDCount };
+
+inline const bool item20Registered = []
+{
+    // Strong owners for the hot set
+    static std::vector<std::shared_ptr<const BenchWidget>> hotWidgets;
+
+    for (BenchWidgetID id = 0; id < hotIDCount; ++id)
+    {
+        hotWidgets.push_back(benchCache.get(id));
+    }
+
+    for (unsigned threads = 1; threads <= 64; threads *= 2)
+    {
+        registerBenchmark("Item 20/hit, " + std::to_string(threads) + " threads", [threads]
+        {
+            return runConcurrently(threads, lookupsPerThread, [](unsigned t, std::size_t i)
+                                   { doNotOptimize(benchCache.get((t * 7919 + i) % hotIDCount)); });
+        }, batchBenchmark);
+
+        registerBenchmark("Item 20/miss, " + std::to_string(threads) + " threads", [threads]
+        {
+            return runConcurrently(threads, lookupsPerThread, [](unsigned, std::size_t)
+                                   {
+                                       auto id = nextColdID.fetch_add(1, std::memory_order_relaxed);
+                                       doNotOptimize(benchCache.get(id));
+                                   });
+        }, batchBenchmark);
+    }
+
+    return true;
+}();
+
+
+/**
+ * An Observer Registry:
+ * A subject that holds its observers as std::weak_ptrs never keeps one alive and never calls one that's gone, but
+ * every notification pays a lock() per observer, an atomic read-modify-write on that observer's control block.
+ * ObserverRegistry keeps that cost as low as it goes and removes everything else from the notification path:
+ *
+ * - Contiguous storage: the observers are a std::vector<std::weak_ptr<Observer>>, so notify walks an array instead of
+ *   chasing list nodes.
+ *
+ * - Batched locking: notify locks batchSize observers into a local array, then calls them all, then releases them.
+ *   The lock()s in a batch don't depend on each other or on the callbacks, so the processor can overlap them, and a
+ *   callback that is slow or re-entrant runs while no registry state is held.
+ *
+ * - Snapshots (copy-on-write, reclaimed RCU-style): the vector is immutable once published. notify loads the current
+ *   snapshot from a std::atomic<std::shared_ptr>, which is one atomic operation per notification rather than a mutex.
+ *   subscribe, unsubscribe and compaction copy the vector under a writers' mutex and publish the copy. A notification
+ *   that is still walking an old snapshot keeps it alive; the last one to finish frees it. snapshot() hands the same
+ *   thing to callers that want to iterate on their own.
+ *
+ * - Lazy compaction: notify counts the expired std::weak_ptrs it meets. When they are more than a quarter of the
+ *   snapshot, it publishes a copy without them, unless another writer holds the mutex, in which case a later
+ *   notification does it. Observers never need to unsubscribe before they die.
+ *
+ * Subscribing copies the whole vector, so the registry suits the usual observer workload: many notifications, few
+ * subscription changes. Subscribing a range of observers at once copies it only once.
+*/
+template<typename Observer>
+class ObserverRegistry
+{
+    public:
+        using Observers = std::vector<std::weak_ptr<Observer>>;
+
+        static constexpr std::size_t batchSize = 64;
+
+        void subscribe(std::weak_ptr<Observer> observer)
+        {
+            std::lock_guard<std::mutex> g { writers };
+
+            auto next = std::make_shared<Observers>(*current.load());
+            next->push_back(std::move(observer));
+            current.store(std::move(next));
+        }
+
+        // Subscribes [first, last) with a single copy of the vector
+        template<typename It>
+        void subscribe(It first, It last)
+        {
+            std::lock_guard<std::mutex> g { writers };
+
+            auto next = std::make_shared<Observers>(*current.load());
+            next->insert(next->end(), first, last);
+            current.store(std::move(next));
+        }
+
+        void unsubscribe(const std::weak_ptr<Observer>& observer)
+        {
+            std::lock_guard<std::mutex> g { writers };
+
+            auto next = std::make_shared<Observers>(*current.load());
+            std::erase_if(*next, [&observer](const auto& o)
+                          { return !o.owner_before(observer) && !observer.owner_before(o); });      // Same object
+            current.store(std::move(next));
+        }
+
+        // Calls notifyOne(Observer&) on every live observer; returns how many were called
+        template<typename F>
+        std::size_t notify(F&& notifyOne)
+        {
+            const auto observers = current.load();
+            std::array<std::shared_ptr<Observer>, batchSize> batch;
+            std::size_t notified = 0, expired = 0;
+
+            for (std::size_t first = 0; first < observers->size(); first += batchSize)
+            {
+                const auto count = std::min(batchSize, observers->size() - first);
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    batch[i] = (*observers)[first + i].lock();
+                    expired += !batch[i];
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (batch[i])
+                    {
+                        notifyOne(*batch[i]);
+                        ++notified;
+                    }
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    batch[i].reset();           // An observer whose last owner let go meanwhile is destroyed here
+                }
+            }
+
+            if (expired * 4 > observers->size())
+            {
+                std::unique_lock<std::mutex> lk { writers, std::try_to_lock };
+
+                if (lk)
+                {
+                    compact();
+                }
+            }
+
+            return notified;
+        }
+
+        std::shared_ptr<const Observers> snapshot() const
+        {
+            return current.load();
+        }
+
+    private:
+        // Called with writers locked; recompacts the current snapshot, which may be newer than the notifier's
+        void compact()
+        {
+            const auto observers = current.load();
+            auto next = std::make_shared<Observers>();
+            next->reserve(observers->size());
+
+            std::copy_if(observers->begin(), observers->end(), std::back_inserter(*next),
+                         [](const auto& o) { return !o.expired(); });
+            current.store(std::move(next));
+        }
+
+        std::mutex writers;
+        std::atomic<std::shared_ptr<const Observers>> current { std::make_shared<const Observers>() };
+};
+
+class Display
+{
+    public:
+        void temperatureChanged(double degrees);
+};
+
+ObserverRegistry<Display> thermometer;
+
+auto display = std::make_shared<Display>();
+thermometer.subscribe(display);
+
+thermometer.notify([](Display& d) { d.temperatureChanged(21.5); });     // Calls display
+display = nullptr;                                                      // No unsubscribe needed
+thermometer.notify([](Display& d) { d.temperatureChanged(22.0); });     // Calls nobody, and compacts
+
+
+/**
+ * Notification Benchmarks:
+ * Each case sends one notification to 10 to 100,000 live observers. The baseline is the textbook subject: a
+ * std::vector<std::weak_ptr> under a mutex held for the whole notification, locking and calling one observer at a
+ * time. The observers are allocated together up front, as an application creating them in a batch would.
+ *
+ * On one thread, expect the two to be close from about a hundred observers up: the lock() and the release of each
+ * observer dominate, and batching doesn't remove them. With only a handful of observers the registry can be slower,
+ * because loading the snapshot from the std::atomic<std::shared_ptr> costs about as much as locking a few observers.
+ *
+ * What the registry removes is the mutex. The 4-notifier cases send four notifications at once from four threads (see
+ * Item 24 for runConcurrently): the mutex subject runs them one after another, while the registry's run in parallel.
+ * onEvent's counter is atomic so concurrent notifications don't race; measure these cases on a machine with at least
+ * four cores.
+*/
+struct CountingObserver
+{
+    std::atomic<std::uint64_t> events { 0 };
+
+    void onEvent(std::uint64_t e) noexcept { events.fetch_add(e, std::memory_order_relaxed); }
+};
+
+class MutexSubject
+{
+    public:
+        void subscribe(std::weak_ptr<CountingObserver> observer)
+        {
+            std::lock_guard<std::mutex> g { m };
+            observers.push_back(std::move(observer));
+        }
+
+        std::size_t notify(std::uint64_t e)
+        {
+            std::lock_guard<std::mutex> g { m };
+            std::size_t notified = 0;
+
+            for (const auto& o : observers)
+            {
+                if (auto observer = o.lock())
+                {
+                    observer->onEvent(e);
+                    ++notified;
+                }
+            }
+
+            return notified;
+        }
+
+    private:
+        std::mutex m;
+        std::vector<std::weak_ptr<CountingObserver>> observers;
+};
+
+inline const bool item20ObserversRegistered = []
+{
+    for (std::size_t count = 10; count <= 100'000; count *= 10)
+    {
+        auto owners = std::make_shared<std::vector<std::shared_ptr<CountingObserver>>>();
+        auto subject = std::make_shared<MutexSubject>();
+        auto registry = std::make_shared<ObserverRegistry<CountingObserver>>();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            owners->push_back(std::make_shared<CountingObserver>());
+            subject->subscribe(owners->back());
+        }
+
+        registry->subscribe(owners->begin(), owners->end());     // One copy, not one per observer
+
+        const auto prefix = "Item 20/notify " + std::to_string(count) + " observers, ";
+
+        registerBenchmark(prefix + "mutex", [owners, subject] { return subject->notify(1); }, batchBenchmark);
+        registerBenchmark(prefix + "registry", [owners, registry]
+        {
+            return registry->notify([](CountingObserver& o) { o.onEvent(1); });
+        }, batchBenchmark);
+
+        registerBenchmark(prefix + "mutex, 4 notifiers", [owners, subject]
+        {
+            return runConcurrently(4, 1, [&subject](unsigned, std::size_t) { subject->notify(1); });
+        }, batchBenchmark);
+        registerBenchmark(prefix + "registry, 4 notifiers", [owners, registry]
+        {
+            return runConcurrently(4, 1, [&registry](unsigned, std::size_t)
+                                   {
+                                       registry->notify([](CountingObserver& o) { o.onEvent(1); });
+                                   });
+        }, batchBenchmark);
+    }
+
+    return true;
+}();
+
+
 /**
  * Efficiency Considerations:
  * `std::weak_ptr` has a similar efficiency profile to `std::shared_ptr`, involving atomic operations for
@@ -1,4 +1,19 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>                                 // sysconf
 /**
  * Prefer std::make_unique and std::make_shared to direct use of new.
  *
@@ -87,4 +102,449 @@ void cusDel(Widget *ptr);       // Custom deleter
 
 std::shared_ptr<Widget> spw { new Widget, cusDel };
 
-processWidget(std::move(spw), computePriority());   // Both efficient and exception safe
\ No newline at end of file
+processWidget(std::move(spw), computePriority());   // Both efficient and exception safe
+
+
+/**
+ * std::allocate_shared:
+ * std::allocate_shared is std::make_shared with an allocator: it still makes a single allocation for the object and the
+ * control block, but gets that memory from the allocator passed as its first argument. It never allocates a T; it
+ * rebinds the allocator to an internal type holding both the control block and the object, so the allocator must
+ * support rebinding and can't assume any particular size.
+*/
+auto spw3 = std::allocate_shared<Widget>(std::allocator<Widget>());
+
+
+/**
+ * A Fixed-Size Pool for Short-Lived Shared Objects:
+ * Millions of short-lived std::make_shared objects mean millions of general-purpose malloc/free pairs. All of those
+ * blocks have the same size (control block plus object), so a pool can hand them out from large chunks and keep freed
+ * blocks on an intrusive free list: allocation and deallocation become a few pointer operations.
+ *
+ * PoolAllocator<T> is a minimal standard allocator over one such pool per block size and alignment. The pool for
+ * std::allocate_shared's rebound control-block type is created on first use, and memory is never returned to the
+ * system; chunks are reused for as long as the program runs.
+ *
+ * ---------------------------------------------------------------------------------------------------------------------
+ *
+ * Threads:
+ * Pools are shared by all threads and guarded by a mutex, because the last std::shared_ptr (or std::weak_ptr) to an
+ * object may be destroyed on a different thread from the one that created it. Uncontended, the lock costs far less than
+ * the malloc it replaces; per-thread caches in front of the pool are the next step if it becomes contended.
+*/
+template<std::size_t BlockSize, std::size_t Alignment>
+class FixedSizePool
+{
+    public:
+        static FixedSizePool& instance()
+        {
+            static FixedSizePool pool;              // Created on first use
+
+            return pool;
+        }
+
+        void* allocate()
+        {
+            std::lock_guard<std::mutex> g { m };
+
+            if (!freeList)
+            {
+                addChunk();
+            }
+
+            auto block = freeList;
+            freeList = freeList->next;
+            ++blocksInUse;
+
+            return block;
+        }
+
+        void deallocate(void* p) noexcept
+        {
+            std::lock_guard<std::mutex> g { m };
+
+            auto block = static_cast<FreeBlock*>(p);
+            block->next = freeList;
+            freeList = block;
+            --blocksInUse;
+        }
+
+        std::size_t bytesInUse() const
+        {
+            std::lock_guard<std::mutex> g { m };
+
+            return blocksInUse * blockSize;
+        }
+
+        std::size_t bytesReserved() const
+        {
+            std::lock_guard<std::mutex> g { m };
+
+            return chunks.size() * blocksPerChunk * blockSize;
+        }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        // Every block must be able to hold a free-list link and keep the next block aligned
+        static constexpr std::size_t blockAlignment = std::max(Alignment, alignof(FreeBlock));
+        static constexpr std::size_t blockSize = (std::max(BlockSize, sizeof(FreeBlock)) + blockAlignment - 1)
+                                                 / blockAlignment * blockAlignment;
+        static constexpr std::size_t blocksPerChunk = std::max<std::size_t>(64 * 1024 / blockSize, 16);
+
+        struct ChunkDeleter
+        {
+            void operator()(std::byte* chunk) const noexcept
+            {
+                ::operator delete(chunk, std::align_val_t { blockAlignment });
+            }
+        };
+
+        void addChunk()
+        {
+            // Owned before it's recorded, so nothing leaks if push_back throws
+            std::unique_ptr<std::byte, ChunkDeleter> chunk {
+                static_cast<std::byte*>(::operator new(blocksPerChunk * blockSize, std::align_val_t { blockAlignment }))
+            };
+            chunks.push_back(std::move(chunk));
+
+            // Thread the new blocks onto the free list, lowest address first
+            for (std::size_t i = blocksPerChunk; i-- > 0; )
+            {
+                freeList = ::new (chunks.back().get() + i * blockSize) FreeBlock { freeList };
+            }
+        }
+
+        mutable std::mutex m;
+        FreeBlock* freeList { nullptr };
+        std::size_t blocksInUse { 0 };
+        std::vector<std::unique_ptr<std::byte, ChunkDeleter>> chunks;
+};
+
+
+template<typename T>
+class PoolAllocator
+{
+    public:
+        using value_type = T;
+
+        PoolAllocator() noexcept = default;
+
+        // Rebinding constructor; std::allocate_shared converts PoolAllocator<Widget> to its control-block type
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept { }
+
+        T* allocate(std::size_t n)
+        {
+            // The pool only serves single objects; arrays go to operator new
+            if (n != 1)
+            {
+                return std::allocator<T>().allocate(n);
+            }
+
+            return static_cast<T*>(pool().allocate());
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            if (n != 1)
+            {
+                std::allocator<T>().deallocate(p, n);
+
+                return;
+            }
+
+            pool().deallocate(p);
+        }
+
+        static FixedSizePool<sizeof(T), alignof(T)>& pool()
+        {
+            return FixedSizePool<sizeof(T), alignof(T)>::instance();
+        }
+
+        // Stateless: any two PoolAllocators can free each other's memory
+        template<typename U>
+        bool operator==(const PoolAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+};
+
+auto spw4 = std::allocate_shared<Widget>(PoolAllocator<Widget>());
+
+
+/**
+ * Benchmarks:
+ * Throughput cases create and destroy one std::shared_ptr per iteration for a small and a large type, using
+ * std::shared_ptr(new T) (two allocations), std::make_shared (one allocation) and std::allocate_shared with
+ * PoolAllocator (one pool block). See Item 24 for registerBenchmark.
+ *
+ * reportRetainedMemory measures the other side of this Item: it creates many objects, keeps only std::weak_ptrs to
+ * them, and reports resident set size. With std::shared_ptr(new T) the objects' memory is freed when the last
+ * std::shared_ptr goes away and only the control blocks are retained. With std::make_shared and std::allocate_shared
+ * the whole fused block stays allocated until the last std::weak_ptr is gone, which for a 4 KB type is the difference
+ * between kilobytes and hundreds of megabytes. Run each report in a fresh process: memory freed back to malloc usually
+ * stays resident, so a later report would reuse it and under-report.
+*/
+struct SmallObject
+{
+    int value { 0 };
+};
+
+struct BigObject
+{
+    std::array<std::byte, 4096> payload { };
+};
+
+// Linux: second field of /proc/self/statm is resident pages, of the kernel's page size (16 or 64 KB on some arm64)
+inline std::size_t residentSetBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    std::size_t totalPages = 0, residentPages = 0;
+    statm >> totalPages >> residentPages;
+
+    return residentPages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+template<typename T, typename Make>
+void reportRetainedMemory(const char* label, Make make, std::size_t count = 100'000)
+{
+    auto before = residentSetBytes();
+
+    std::vector<std::weak_ptr<T>> lingering;
+    lingering.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto sp = make();
+        lingering.push_back(sp);
+    }                                               // Last std::shared_ptr gone; only std::weak_ptrs remain
+
+    std::cout << label << ": " << (residentSetBytes() - before) / 1024 << " KB retained by " << count
+              << " weak_ptrs\n";
+}
+
+inline const bool item21Registered = []
+{
+    registerBenchmark("Item 21/shared_ptr(new SmallObject)",
+                      [] { return std::shared_ptr<SmallObject>(new SmallObject); });
+    registerBenchmark("Item 21/make_shared<SmallObject>", [] { return std::make_shared<SmallObject>(); });
+    registerBenchmark("Item 21/allocate_shared<SmallObject>, pool",
+                      [] { return std::allocate_shared<SmallObject>(PoolAllocator<SmallObject>()); });
+
+    registerBenchmark("Item 21/shared_ptr(new BigObject)", [] { return std::shared_ptr<BigObject>(new BigObject); });
+    registerBenchmark("Item 21/make_shared<BigObject>", [] { return std::make_shared<BigObject>(); });
+    registerBenchmark("Item 21/allocate_shared<BigObject>, pool",
+                      [] { return std::allocate_shared<BigObject>(PoolAllocator<BigObject>()); });
+
+    return true;
+}();
+
+reportRetainedMemory<BigObject>("shared_ptr(new BigObject)", [] { return std::shared_ptr<BigObject>(new BigObject); });
+reportRetainedMemory<BigObject>("make_shared<BigObject>", [] { return std::make_shared<BigObject>(); });
+reportRetainedMemory<BigObject>("allocate_shared<BigObject>, pool",
+                                [] { return std::allocate_shared<BigObject>(PoolAllocator<BigObject>()); });
+
+
+/**
+ * Accounting for Every Allocation:
+ * Resident set size answers "how much did the process keep", but not "how many allocations, of how many bytes, does
+ * each smart pointer configuration make", which is what cache sizing needs. Replacing the global operator new and
+ * operator delete answers that exactly. The replacements put a small header in front of every block recording its
+ * requested size, so operator delete knows how many bytes it gives back, and count into heapCounts.
+ *
+ * heapCounts is per thread, so allocations made by other threads (a pool's workers, say) don't show up in a report. A
+ * block freed on a different thread from the one that allocated it moves bytes between the two threads' counts, which
+ * is why liveBytes is signed; the reports below allocate and free on one thread.
+ *
+ * Only the plain and aligned single-object forms of operator new need replacing, since the default array and nothrow
+ * forms call them. The sized forms of operator delete are replaced too, as GCC expects them alongside the unsized ones.
+*/
+struct HeapCounts
+{
+    std::size_t allocations { 0 };
+    std::ptrdiff_t liveBytes { 0 };             // Requested bytes not yet freed
+};
+
+inline thread_local HeapCounts heapCounts;
+
+namespace detail
+{
+    // Big enough for the size and keeps the block after it aligned for any fundamental type
+    constexpr std::size_t heapHeaderSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    inline void* countedAllocate(std::size_t size, std::size_t alignment)
+    {
+        const auto header = std::max(heapHeaderSize, alignment);
+        const auto total = (header + size + alignment - 1) / alignment * alignment;        // aligned_alloc needs this
+
+        auto base = static_cast<std::byte*>(alignment <= heapHeaderSize ? std::malloc(total)
+                                                                         : std::aligned_alloc(alignment, total));
+
+        if (!base)
+        {
+            throw std::bad_alloc();
+        }
+
+        ::new (base + header - sizeof(std::size_t)) std::size_t(size);
+        ++heapCounts.allocations;
+        heapCounts.liveBytes += static_cast<std::ptrdiff_t>(size);
+
+        return base + header;
+    }
+
+    inline void countedFree(void* p, std::size_t alignment) noexcept
+    {
+        if (!p)
+        {
+            return;
+        }
+
+        const auto header = std::max(heapHeaderSize, alignment);
+        auto block = static_cast<std::byte*>(p);
+
+        auto size = *std::launder(reinterpret_cast<std::size_t*>(block - sizeof(std::size_t)));
+
+        heapCounts.liveBytes -= static_cast<std::ptrdiff_t>(size);
+        std::free(block - header);
+    }
+}
+
+void* operator new(std::size_t size) { return detail::countedAllocate(size, detail::heapHeaderSize); }
+void* operator new(std::size_t size, std::align_val_t a) { return detail::countedAllocate(size, std::size_t(a)); }
+void operator delete(void* p) noexcept { detail::countedFree(p, detail::heapHeaderSize); }
+void operator delete(void* p, std::align_val_t a) noexcept { detail::countedFree(p, std::size_t(a)); }
+void operator delete(void* p, std::size_t) noexcept { detail::countedFree(p, detail::heapHeaderSize); }
+void operator delete(void* p, std::size_t, std::align_val_t a) noexcept { detail::countedFree(p, std::size_t(a)); }
+
+
+/**
+ * Footprint per Configuration:
+ * reportFootprint makes one handle and reports its size, plus the allocations and heap bytes it holds while it's alive.
+ * With GCC 12 on x86-64, for a 64-byte Investment:
+ *
+ * - std::unique_ptr, default or stateless-lambda deleter: 8 bytes, 1 allocation, 64 heap bytes.
+ *
+ * - std::unique_ptr with a void (*)(Investment*) deleter: 16 bytes, the same heap use.
+ *
+ * - std::shared_ptr(new): 16 bytes, 2 allocations, 64 + 24 heap bytes for the object and the control block (vptr, two
+ *   counts and the pointer to delete). A custom deleter adds nothing to the handle; a stateless one adds nothing to the
+ *   control block either, a function pointer adds 8 bytes to it.
+ *
+ * - std::make_shared: 16 bytes, 1 allocation, 64 + 16 heap bytes: the fused block needs no separate pointer.
+ *
+ * - std::allocate_shared with PoolAllocator: 16 bytes, no global allocations once the pool has a chunk; the fused
+ *   block comes out of the pool instead.
+ *
+ * - std::weak_ptr: 16 bytes and no allocations of its own. What it costs is what it keeps alive, charted next.
+*/
+struct Investment
+{
+    std::array<std::byte, 64> state { };
+};
+
+template<typename Make>
+void reportFootprint(const std::string& label, Make make)
+{
+    const auto before = heapCounts;
+    auto handle = make();
+    const auto held = heapCounts;
+
+    std::cout << std::left << std::setw(52) << label << std::right << std::setw(8) << sizeof(handle)
+              << std::setw(13) << held.allocations - before.allocations
+              << std::setw(12) << held.liveBytes - before.liveBytes << "\n";
+}
+
+inline void reportSmartPointerFootprints()
+{
+    std::cout << std::left << std::setw(52) << "Configuration" << std::right << std::setw(8) << "handle"
+              << std::setw(13) << "allocations" << std::setw(12) << "heap bytes" << "\n";
+
+    auto statelessDel = [](Investment* p) { delete p; };
+    void (*functionDel)(Investment*) = [](Investment* p) { delete p; };
+
+    reportFootprint("unique_ptr<Investment>", [] { return std::make_unique<Investment>(); });
+    reportFootprint("unique_ptr<Investment, stateless lambda>", [&]
+    {
+        return std::unique_ptr<Investment, decltype(statelessDel)>(new Investment, statelessDel);
+    });
+    reportFootprint("unique_ptr<Investment, void (*)(Investment*)>", [&]
+    {
+        return std::unique_ptr<Investment, void (*)(Investment*)>(new Investment, functionDel);
+    });
+
+    reportFootprint("shared_ptr(new Investment)", [] { return std::shared_ptr<Investment>(new Investment); });
+    reportFootprint("shared_ptr(new Investment, stateless lambda)", [&]
+    {
+        return std::shared_ptr<Investment>(new Investment, statelessDel);
+    });
+    reportFootprint("shared_ptr(new Investment, void (*)(Investment*))", [&]
+    {
+        return std::shared_ptr<Investment>(new Investment, functionDel);
+    });
+    reportFootprint("make_shared<Investment>", [] { return std::make_shared<Investment>(); });
+
+    auto warm = std::allocate_shared<Investment>(PoolAllocator<Investment>());            // Pool's first chunk
+    reportFootprint("allocate_shared<Investment>, pool",
+                    [] { return std::allocate_shared<Investment>(PoolAllocator<Investment>()); });
+
+    auto owner = std::make_shared<Investment>();
+    reportFootprint("weak_ptr<Investment>", [&] { return std::weak_ptr<Investment>(owner); });
+}
+
+reportSmartPointerFootprints();
+
+
+/**
+ * Memory Retained by std::weak_ptr:
+ * chartWeakRetention makes one object of each size, keeps only a std::weak_ptr to it, and charts the heap bytes still
+ * live. With std::shared_ptr(new T) that's the 24-byte control block, whatever the size of T. With std::make_shared
+ * it's the control block plus the whole object, so it grows linearly with sizeof(T): a cache holding std::weak_ptrs to
+ * expired 64 KB entries made with std::make_shared still pays 64 KB for each. The bars are on a log2 scale, one mark
+ * per doubling.
+*/
+template<std::size_t Size>
+struct Payload
+{
+    std::array<std::byte, Size> bytes { };
+};
+
+template<typename T, typename Make>
+std::ptrdiff_t retainedByWeakPtr(Make make)
+{
+    const auto before = heapCounts;
+    std::weak_ptr<T> wp;
+
+    {
+        auto sp = make();
+        wp = sp;
+    }                                           // Last std::shared_ptr gone
+
+    return heapCounts.liveBytes - before.liveBytes;
+}
+
+inline std::string log2Bar(std::ptrdiff_t bytes)
+{
+    return std::string(bytes > 0 ? std::bit_width(static_cast<std::size_t>(bytes)) : 0, '#');
+}
+
+template<std::size_t... Sizes>
+void chartWeakRetention(std::index_sequence<Sizes...>)
+{
+    std::cout << std::setw(9) << "sizeof(T)" << std::setw(14) << "new T" << std::setw(14) << "make_shared" << "\n";
+
+    auto row = [](std::size_t size, std::ptrdiff_t fromNew, std::ptrdiff_t fromMake)
+    {
+        std::cout << std::setw(9) << size << std::setw(14) << fromNew << std::setw(14) << fromMake << "  "
+                  << std::left << std::setw(24) << log2Bar(fromNew) << log2Bar(fromMake) << std::right << "\n";
+    };
+
+    (row(Sizes,
+         retainedByWeakPtr<Payload<Sizes>>([] { return std::shared_ptr<Payload<Sizes>>(new Payload<Sizes>); }),
+         retainedByWeakPtr<Payload<Sizes>>([] { return std::make_shared<Payload<Sizes>>(); })), ...);
+}
+
+chartWeakRetention(std::index_sequence<16, 64, 256, 1024, 4096, 16384, 65536> { });
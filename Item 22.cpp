@@ -1,4 +1,11 @@
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 /**
  * When using Pimpl Idiom, define special member functions in the implementation file.
  *
@@ -176,4 +183,313 @@ class Widget .
 
         // std::shared_ptr instead of std::unique_ptr
         std::shared_ptr<Impl> pImpl;
-};
\ No newline at end of file
+};
+
+
+/**
+ * Fast Pimpl:
+ * The std::unique_ptr version pays a heap allocation for every Widget constructed or copied, and a pointer chase on
+ * every access. For small widgets that are created often, that allocation dominates. FastPimpl keeps the compile
+ * firewall but stores Impl inside Widget, in a suitably aligned byte buffer:
+ *
+ * - The header still only declares Impl. It states how much room Impl needs (Size and Alignment), and that's the only
+ *   thing about Impl clients depend on; changing Impl's members doesn't touch the header unless it outgrows Size.
+ *
+ * - Every member that needs the complete Impl is a template, so it's instantiated only where Widget's special member
+ *   functions are defined: in widget.cpp, exactly as with std::unique_ptr. Every member reaches the buffer through
+ *   place or get, which check Size and Alignment against the real sizeof(Impl) and alignof(Impl), so getting them
+ *   wrong is a compile error, not memory corruption, whichever members a class happens to define. The values appear as
+ *   template arguments in the diagnostic, which tells you what to change them to.
+ *
+ * - Constructing Impl from arguments takes std::in_place, so the forwarding constructor can't hijack copies of a
+ *   non-const FastPimpl (see Item 26).
+ *
+ * Moving a FastPimpl moves the Impl, rather than stealing a pointer. For Impls made of std::strings and std::vectors
+ * that's still a handful of pointer copies, and it leaves the moved-from Widget usable, which the std::unique_ptr
+ * version doesn't.
+*/
+template<typename T, std::size_t Size, std::size_t Alignment>
+class FastPimpl
+{
+    public:
+        FastPimpl() { ::new (place()) T(); }
+
+        template<typename... Args>
+        explicit FastPimpl(std::in_place_t, Args&&... args)
+        {
+            ::new (place()) T(std::forward<Args>(args)...);
+        }
+
+        FastPimpl(const FastPimpl& rhs) { ::new (place()) T(*rhs); }
+
+        FastPimpl(FastPimpl&& rhs) noexcept
+        {
+            static_assert(std::is_nothrow_move_constructible_v<T>);
+            ::new (place()) T(std::move(*rhs));
+        }
+
+        FastPimpl& operator=(const FastPimpl& rhs)
+        {
+            **this = *rhs;
+
+            return *this;
+        }
+
+        FastPimpl& operator=(FastPimpl&& rhs) noexcept
+        {
+            **this = std::move(*rhs);
+
+            return *this;
+        }
+
+        ~FastPimpl() { get()->~T(); }
+
+        T* operator->() noexcept { return get(); }
+        const T* operator->() const noexcept { return get(); }
+        T& operator*() noexcept { return *get(); }
+        const T& operator*() const noexcept { return *get(); }
+
+    private:
+        template<std::size_t ActualSize, std::size_t ActualAlignment>
+        static constexpr void validate() noexcept
+        {
+            static_assert(ActualSize <= Size, "FastPimpl: Size is smaller than sizeof(T); see ActualSize");
+            static_assert(Alignment % ActualAlignment == 0, "FastPimpl: Alignment doesn't satisfy alignof(T)");
+        }
+
+        // The buffer a T is about to be constructed in
+        void* place() noexcept
+        {
+            validate<sizeof(T), alignof(T)>();
+
+            return storage;
+        }
+
+        T* get() noexcept
+        {
+            validate<sizeof(T), alignof(T)>();
+
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+
+        const T* get() const noexcept
+        {
+            validate<sizeof(T), alignof(T)>();
+
+            return std::launder(reinterpret_cast<const T*>(storage));
+        }
+
+        alignas(Alignment) std::byte storage[Size];
+};
+
+// In "widget.h"
+class InlineWidget
+{
+    public:
+        InlineWidget();
+        ~InlineWidget();
+
+        InlineWidget(const InlineWidget& rhs);
+        InlineWidget& operator=(const InlineWidget& rhs);
+
+        InlineWidget(InlineWidget&& rhs) noexcept;
+        InlineWidget& operator=(InlineWidget&& rhs) noexcept;
+
+    private:
+        struct Impl;
+        FastPimpl<Impl, 64, 8> pImpl;           // sizeof(Impl) with libstdc++ and MSVC x64; checked in widget.cpp
+};
+
+// In "widget.cpp"
+struct InlineWidget::Impl
+{
+    std::string name;
+    std::vector<double> data;
+
+    Gadget g1, g2, g3;
+};
+
+InlineWidget::InlineWidget() = default;                 // No allocation
+InlineWidget::~InlineWidget() = default;                // Size and alignment checked here, as in every member
+
+InlineWidget::InlineWidget(const InlineWidget& rhs) = default;
+InlineWidget& InlineWidget::operator=(const InlineWidget& rhs) = default;
+
+InlineWidget::InlineWidget(InlineWidget&& rhs) noexcept = default;
+InlineWidget& InlineWidget::operator=(InlineWidget&& rhs) noexcept = default;
+
+
+/**
+ * Copy-on-Write Pimpl:
+ * When widgets are copied often but modified rarely, the copies don't have to be deep. CowPimpl shares one
+ * reference-counted Impl among copies; copying is an atomic increment, and the Impl is cloned only when a shared one is
+ * about to be modified. Readers use read, writers use modify, which is what makes the sharing safe to hide. modify
+ * passes the unshared Impl to a callable rather than returning a reference: a T& kept after the call would alias the
+ * next copy's Impl, so writes through it would show up in the copy too.
+ *
+ * The count lives next to Impl in one allocation, the way std::make_shared lays out its control block (see Item 21),
+ * but it's a single count and there are no weak references. modify loads it with acquire ordering: if it sees 1, every
+ * other owner's reads have happened before their releasing decrements, so modifying in place is safe. std::shared_ptr's
+ * use_count can't promise that, which is why CowPimpl doesn't use it.
+ *
+ * As with the std::unique_ptr version, a moved-from Widget may only be assigned to or destroyed.
+*/
+template<typename T>
+class CowPimpl
+{
+    public:
+        CowPimpl() : block(new Block()) { }
+
+        template<typename... Args>
+        explicit CowPimpl(std::in_place_t, Args&&... args) : block(new Block(std::forward<Args>(args)...)) { }
+
+        CowPimpl(const CowPimpl& rhs) noexcept : block(rhs.block)
+        {
+            block->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        CowPimpl(CowPimpl&& rhs) noexcept : block(std::exchange(rhs.block, nullptr)) { }
+
+        // By value: covers copy and move assignment, and self-assignment
+        CowPimpl& operator=(CowPimpl rhs) noexcept
+        {
+            std::swap(block, rhs.block);
+
+            return *this;
+        }
+
+        ~CowPimpl() { release(); }
+
+        const T& read() const noexcept { return block->value; }
+
+        // f gets the only reference to the Impl; it must not keep it past the call
+        template<typename F>
+        void modify(F&& f)
+        {
+            if (block->refs.load(std::memory_order_acquire) != 1)
+            {
+                auto unshared = new Block(std::as_const(block->value));
+
+                release();
+                block = unshared;
+            }
+
+            std::forward<F>(f)(block->value);
+        }
+
+    private:
+        struct Block
+        {
+            template<typename... Args>
+            explicit Block(Args&&... args) : value(std::forward<Args>(args)...) { }
+
+            std::atomic<std::size_t> refs { 1 };
+            T value;
+        };
+
+        void release() noexcept
+        {
+            if (block && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete block;
+            }
+        }
+
+        Block* block;
+};
+
+// In "widget.h"
+class CowWidget
+{
+    public:
+        CowWidget();
+        ~CowWidget();
+
+        CowWidget(const CowWidget& rhs);
+        CowWidget& operator=(const CowWidget& rhs);
+
+        CowWidget(CowWidget&& rhs) noexcept;
+        CowWidget& operator=(CowWidget&& rhs) noexcept;
+
+        const std::string& name() const noexcept;
+        void setName(std::string newName);
+
+    private:
+        struct Impl;
+        CowPimpl<Impl> pImpl;
+};
+
+// In "widget.cpp"
+struct CowWidget::Impl
+{
+    std::string name;
+    std::vector<double> data;
+
+    Gadget g1, g2, g3;
+};
+
+CowWidget::CowWidget() = default;
+CowWidget::~CowWidget() = default;
+
+CowWidget::CowWidget(const CowWidget& rhs) = default;                  // Shares rhs's Impl
+CowWidget& CowWidget::operator=(const CowWidget& rhs) = default;
+
+CowWidget::CowWidget(CowWidget&& rhs) noexcept = default;
+CowWidget& CowWidget::operator=(CowWidget&& rhs) noexcept = default;
+
+const std::string& CowWidget::name() const noexcept { return pImpl.read().name; }
+void CowWidget::setName(std::string newName)                            // Clones if shared
+{
+    pImpl.modify([&](Impl& impl) { impl.name = std::move(newName); });
+}
+
+
+/**
+ * Benchmarks:
+ * Construction, copy and move of a default-constructed widget, for the std::unique_ptr Widget above and the two
+ * variants (see Item 24 for registerBenchmark). Widget allocates on construction and copy. InlineWidget never does,
+ * but its copies are deep. CowWidget allocates on construction, its copies are a reference count increment, and the
+ * last case shows what a copy costs when it's then modified. Moves of Widget and CowWidget swap a pointer, where
+ * InlineWidget moves its members.
+*/
+inline const bool item22Registered = []
+{
+    registerBenchmark("Item 22/construct, unique_ptr", [] { return Widget(); });
+    registerBenchmark("Item 22/construct, FastPimpl", [] { return InlineWidget(); });
+    registerBenchmark("Item 22/construct, CowPimpl", [] { return CowWidget(); });
+
+    registerBenchmark("Item 22/copy, unique_ptr", [w = Widget()] { return Widget(w); });
+    registerBenchmark("Item 22/copy, FastPimpl", [w = InlineWidget()] { return InlineWidget(w); });
+    registerBenchmark("Item 22/copy, CowPimpl", [w = CowWidget()] { return CowWidget(w); });
+    registerBenchmark("Item 22/copy and modify, CowPimpl", [w = CowWidget()]
+    {
+        CowWidget copy(w);
+        copy.setName("Persephone");
+
+        return copy;
+    });
+
+    registerBenchmark("Item 22/move, unique_ptr", [w = Widget()]() mutable
+    {
+        Widget moved(std::move(w));
+        w = std::move(moved);
+
+        return &w;
+    });
+    registerBenchmark("Item 22/move, FastPimpl", [w = InlineWidget()]() mutable
+    {
+        InlineWidget moved(std::move(w));
+        w = std::move(moved);
+
+        return &w;
+    });
+    registerBenchmark("Item 22/move, CowPimpl", [w = CowWidget()]() mutable
+    {
+        CowWidget moved(std::move(w));
+        w = std::move(moved);
+
+        return &w;
+    });
+
+    return true;
+}();
@@ -84,6 +84,21 @@ logAndProcess(w);                                   // Call with lvalue
 logAndProcess(std::move(w));                        // Call with rvalue
 
 
+/**
+ * Logging Off the Hot Path:
+ * logAndProcess pays for makeLogEntry on every call before process even starts. With the asynchronous backend from
+ * Item 26, the entry is one record written to the calling thread's ring buffer, stamped with steady_clock; formatting
+ * and I/O happen later on the flusher thread. param is still forwarded exactly once.
+*/
+template<typename T>
+void logAndProcess(T&& param)
+{
+    log(LogClock::now(), "Calling 'process'");         // A few nanoseconds; see Item 26
+
+    process(std::forward<T>(param));
+}
+
+
 
 /**
  * Usage Contexts and Differences:
@@ -1,3 +1,11 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 /**
@@ -91,14 +99,192 @@ void someFunc(MyTemplateType&& param);      // param is a universal reference
 auto timeFuncInvocation = [](auto&& func, auto&&... params)
 {
     // Start timer
+    auto start = std::chrono::steady_clock::now();
 
     // Invoke func on params
     std::forward<decltype(func)>(func)(std::forward<decltype(params)>(params)... );
 
-    // Stop timer and record elapsed time;
+    // Stop timer and record elapsed time
+    return std::chrono::steady_clock::now() - start;
 };
 
 
+/**
+ * From Sketch to Benchmark Harness:
+ * A single timed call says very little: the first invocation pays for cold caches and page faults, the clock has a
+ * resolution of its own, and the optimizer is free to delete a call whose result is never used. A usable harness
+ * therefore warms up first, takes many samples, keeps results alive with a do-not-optimize barrier, and reports the
+ * median and the tail (p99) rather than a mean that a single outlier can drag around.
+ *
+ * ---------------------------------------------------------------------------------------------------------------------
+ *
+ * Forwarding Inside a Loop:
+ * Note that func and params are forwarded exactly once in timeFuncInvocation above. In a sampling loop they must be used
+ * as lvalues; forwarding an rvalue on every iteration would move from the same object over and over.
+*/
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+    // Pretend to read value from memory so the computation producing it can't be discarded (GCC/Clang)
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory()
+{
+    // Pretend that all memory may have been written so stores can't be sunk out of the timed region
+    asm volatile("" : : : "memory");
+}
+
+struct BenchmarkOptions
+{
+    std::size_t warmupRuns { 10 };
+    std::size_t samples { 101 };
+    std::size_t iterationsPerSample { 1000 };
+};
+
+// For cases whose body is already a batch (many threads, tasks or elements): a few samples of one call each
+inline constexpr BenchmarkOptions batchBenchmark { 1, 21, 1 };
+
+struct BenchmarkResult
+{
+    std::string name;
+    std::chrono::nanoseconds median;            // Per iteration
+    std::chrono::nanoseconds p99;               // Per iteration
+};
+
+auto sampleFuncInvocation = [](const BenchmarkOptions& opts, auto&& func, auto&&... params)
+{
+    using namespace std::chrono;
+
+    // Warm up caches, branch predictors and lazily-initialized state
+    for (std::size_t i = 0; i < opts.warmupRuns; ++i)
+    {
+        doNotOptimize(func(params...));
+    }
+
+    // At least one sample of at least one iteration, so there's always a median and never a division by zero
+    const auto samples = std::max<std::size_t>(opts.samples, 1);
+    const auto iterations = std::max<std::size_t>(opts.iterationsPerSample, 1);
+
+    std::vector<nanoseconds> perIteration;
+    perIteration.reserve(samples);
+
+    for (std::size_t s = 0; s < samples; ++s)
+    {
+        auto start = steady_clock::now();
+
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            doNotOptimize(func(params...));     // func and params used as lvalues; see above
+        }
+
+        clobberMemory();
+        auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start);
+        perIteration.push_back(elapsed / iterations);
+    }
+
+    std::sort(perIteration.begin(), perIteration.end());
+
+    return std::pair { perIteration[perIteration.size() / 2], perIteration[(perIteration.size() * 99) / 100] };
+};
+
+
+/**
+ * Registering Benchmarks:
+ * Every Item that makes a performance claim registers the cases that back it up with registerBenchmark. Registration
+ * happens through the initializer of an inline variable, so an Item only has to be linked into the benchmark binary for
+ * its cases to run; runAllBenchmarks is that binary's entire main.
+ *
+ * The Items themselves are annotated notes rather than translation units: they repeat declarations and put statements
+ * at namespace scope, so this tree has no benchmark binary to build. A case is run by copying the harness above and
+ * the Item's code it needs into a file of its own. For the same reason the Items describe what their cases compare
+ * and what to expect, but don't quote timings.
+ *
+ * Benchmarked callables return a value (any value) that the harness feeds to doNotOptimize.
+ *
+ * A case can pass its own BenchmarkOptions, which then take precedence over the ones given to runAllBenchmarks. Cases
+ * whose body is already a batch (a thousand threads, a million elements, a hundred thousand observers) pass
+ * batchBenchmark; with the default options they would run 101,000 times. With 21 samples, their p99 is the slowest
+ * sample.
+*/
+using BenchmarkFunc = std::function<BenchmarkResult(const BenchmarkOptions&)>;
+
+inline std::vector<std::pair<std::string, BenchmarkFunc>>& benchmarkRegistry()
+{
+    static std::vector<std::pair<std::string, BenchmarkFunc>> registry;      // Built on first use (no init order fiasco)
+
+    return registry;
+}
+
+template<typename Func>
+bool registerBenchmark(std::string name, Func func, std::optional<BenchmarkOptions> options = std::nullopt)
+{
+    // mutable: a case may keep state (a container it fills, a counter) across iterations
+    auto run = [name, func = std::move(func), options](const BenchmarkOptions& opts) mutable
+    {
+        auto [median, p99] = sampleFuncInvocation(options.value_or(opts), func);
+
+        return BenchmarkResult { name, median, p99 };
+    };
+
+    benchmarkRegistry().emplace_back(std::move(name), std::move(run));
+
+    return true;
+}
+
+inline std::vector<BenchmarkResult> runAllBenchmarks(const BenchmarkOptions& opts = { })
+{
+    std::vector<BenchmarkResult> results;
+
+    for (const auto& [name, run] : benchmarkRegistry())
+    {
+        auto result = run(opts);
+        std::cout << result.name << ": median " << result.median.count() << " ns, p99 " << result.p99.count() << " ns\n";
+        results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+/**
+ * Multi-Threaded Cases:
+ * Contention claims can only be measured with several threads hammering the same object. runConcurrently runs
+ * body(thread, i) iterationsPerThread times on each of threadCount threads and returns once all of them are done, so a
+ * registered case can wrap it and get the time for the whole batch. Thread start-up is part of that time; enough
+ * iterations per thread make it negligible.
+*/
+template<typename Body>
+std::size_t runConcurrently(unsigned threadCount, std::size_t iterationsPerThread, Body body)
+{
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(threadCount);
+
+        for (unsigned t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&body, t, iterationsPerThread]
+                                 {
+                                     for (std::size_t i = 0; i < iterationsPerThread; ++i)
+                                     {
+                                         body(t, i);
+                                     }
+                                 });
+        }
+    }                                               // std::jthreads join here
+
+    return threadCount * iterationsPerThread;
+}
+
+// Registration from an Item: the lambda is the measured body
+inline const bool item24Registered = registerBenchmark("Item 24/forward vs copy",
+                                                       [s = std::string(64, 'x')] { return std::string(s).size(); });
+
+int main()
+{
+    runAllBenchmarks();
+}
+
+
 /**
  * Concept of Abstraction and Reference Collapsing:
  * The entire concept of universal references is an abstraction built over the more complex underlying
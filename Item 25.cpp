@@ -1,4 +1,7 @@
+#include <cstddef>
+#include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 #include <string>
 /**
@@ -92,6 +95,18 @@ void setSignText(T&& text)                              // text is universal ref
     signHistory.add(now, std::forward<T>(text));        // conditionally cast text to rvalue
 }
 
+// With Item 26's logging backend: the record stores the literal and text's length, never a copy of text
+template<typename T>
+void setSignText(T&& text)
+{
+    sign.setText(text);
+
+    auto now = std::chrono::system_clock::now();
+
+    log(now, "setSignText", text.size());               // Formatted later, on the flusher thread
+    signHistory.add(now, std::forward<T>(text));        // Still the last use of text
+}
+
 /**
  * Returning References from Functions:
  * When returning a reference from a function, it's recommended to apply std::move or std::forward to
@@ -112,3 +127,111 @@ void setSignText(T&& text)                              // text is universal ref
  * be treated as an rvalue. This means that explicitly using std::move on a local object being returned is
  * redundant and can potentially hinder compiler optimizations.
 */
+
+
+/**
+ * Checking Copies and Moves:
+ * A refactor that turns an elided return into a move, or a move into a copy, still compiles and still gives the right
+ * answer, so the counts are checked instead. expectCounts runs an operation on TrackedString from Item 42, which counts
+ * its constructions, copies, moves and destructions, and throws std::logic_error if the operation copied or moved more
+ * often than expected, or left an object it created undestroyed. Copy and move assignments count as copies and moves.
+ * checkReturnPatterns runs where the Item's reports run, so a regression stops the program at start-up instead of
+ * showing up in a profile.
+ *
+ * The expectations are upper bounds: a compiler that elides more is fine. NRVO is permitted rather than required, but
+ * GCC, Clang and MSVC all apply it to a function with a single named return value, so makeNamed expects no moves, and
+ * a std::move added to it shows up as one. GCC's -Wpessimizing-move flags the same mistake at compile time.
+*/
+struct ExpectedCounts
+{
+    std::size_t copies = 0, moves = 0;
+};
+
+template<typename Operation>
+void expectCounts(const std::string& pattern, ExpectedCounts most, Operation op)
+{
+    counts = { };
+
+    op();
+
+    const auto copies = counts.copies + counts.copyAssignments;
+    const auto moves = counts.moves + counts.moveAssignments;
+    const auto constructions = counts.fromLiteral + counts.copies + counts.moves;
+
+    std::cout << pattern << ": " << copies << " copies, " << moves << " moves (at most " << most.copies << " and "
+              << most.moves << ")\n";
+
+    if (copies > most.copies || moves > most.moves || constructions != counts.destructions)
+    {
+        throw std::logic_error(pattern + ": " + std::to_string(copies) + " copies and " + std::to_string(moves)
+                               + " moves, expected at most " + std::to_string(most.copies) + " and "
+                               + std::to_string(most.moves) + "; " + std::to_string(constructions)
+                               + " constructions, " + std::to_string(counts.destructions) + " destructions");
+    }
+}
+
+TrackedString makeNamed()                           // NRVO
+{
+    TrackedString s("name");
+
+    return s;
+}
+
+TrackedString makeMoved()                           // std::move disables NRVO
+{
+    TrackedString s("name");
+
+    return std::move(s);
+}
+
+TrackedString makeTemporary()                       // Guaranteed elision since C++17
+{
+    return TrackedString("name");
+}
+
+TrackedString makeEither(bool first)                // Two named candidates, so no NRVO; returned as rvalues
+{
+    TrackedString a("a");
+    TrackedString b("b");
+
+    if (first)
+    {
+        return a;
+    }
+
+    return b;
+}
+
+TrackedString passThrough(TrackedString s)          // Parameters are never elided, but are returned as rvalues
+{
+    return s;
+}
+
+TrackedString fromRvalue(TrackedString&& s)         // Rvalue reference: std::move
+{
+    return std::move(s);
+}
+
+template<typename T>
+TrackedString fromUniversal(T&& s)                  // Universal reference: std::forward
+{
+    return std::forward<T>(s);
+}
+
+inline void checkReturnPatterns()
+{
+    const TrackedString lvalue("lvalue");
+
+    expectCounts("return local", { 0, 0 }, [] { auto s = makeNamed(); });
+    expectCounts("return std::move(local)", { 0, 1 }, [] { auto s = makeMoved(); });
+    expectCounts("return temporary", { 0, 0 }, [] { auto s = makeTemporary(); });
+    expectCounts("return one of two locals", { 0, 1 }, [] { auto s = makeEither(true); });
+    expectCounts("return by-value parameter, lvalue", { 1, 1 }, [&] { auto s = passThrough(lvalue); });
+    expectCounts("return by-value parameter, prvalue", { 0, 1 }, [] { auto s = passThrough(makeTemporary()); });
+    expectCounts("return std::move(rvalue reference)", { 0, 1 }, [] { auto s = fromRvalue(makeTemporary()); });
+    expectCounts("return std::forward(universal reference), lvalue", { 1, 0 }, [&] { auto s = fromUniversal(lvalue); });
+    expectCounts("return std::forward(universal reference), rvalue", { 0, 1 },
+                 [] { auto s = fromUniversal(makeTemporary()); });
+}
+
+checkReturnPatterns();
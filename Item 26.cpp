@@ -1,7 +1,27 @@
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <ranges>
 #include <set>
+#include <sstream>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 /**
  * Avoid overloading on universal references.
  *
@@ -116,3 +136,578 @@ class SpecialPerson: public Person
  * on universal references. If different handling for certain types is required, alternative solutions should
  * be sought.
 */
+
+
+/**
+ * An Asynchronous Logging Backend:
+ * logAndAdd (and logAndProcess in Item 23, setSignText in Item 25) logs on the hot path. A synchronous log formats the
+ * entry, takes a lock and writes to a stream before the caller can get on with its work. This backend keeps only the
+ * cheap part on the caller's thread:
+ *
+ * - Each thread owns a LogRing, a single-producer single-consumer ring of fixed-size LogRecords. log claims a slot and
+ *   publishes it with one release store. There are no locks and no allocation after the thread's first call. When the
+ *   ring is full the record is dropped and counted, rather than making the caller wait.
+ *
+ * - Formatting is deferred. A record holds the message pointer, the raw bytes of the arguments, and a pointer to
+ *   formatLogRecord instantiated for the argument types. Arguments must therefore be integers, floating-point values,
+ *   bools or object pointers. A const char* is printed as a string and must outlive the flush, as string literals do;
+ *   any other pointer is printed as an address.
+ *
+ * - AsyncLogger's flusher thread wakes every millisecond, drains every ring, formats the records into one string and
+ *   writes the whole batch to the sink in a single call. Rings whose threads have exited are released once they're
+ *   drained.
+ *
+ * - Timestamps are whatever the caller passes. log(now, ...) keeps the book's signature for system_clock, and the
+ *   overload without a time point stamps the record with steady_clock (LogClock), which is monotonic and on Linux is
+ *   read through the vDSO without a system call. A TSC read would be cheaper still, but isn't portable.
+*/
+using LogClock = std::chrono::steady_clock;
+
+struct alignas(64) LogRecord                                // One cache line, so neighbouring slots never share one
+{
+    static constexpr std::size_t payloadSize = 40;          // Fills the line with the three fields before it
+
+    std::int64_t timestamp;                                 // Nanoseconds since the clock's epoch
+    const char* message;
+    void (*format)(std::string&, const LogRecord&);         // Knows the argument types; runs on the flusher
+    alignas(8) std::byte payload[payloadSize];              // Arguments, back to back
+};
+
+inline void appendLogValue(std::string& out, const char* s) { out += s; }
+inline void appendLogValue(std::string& out, bool b) { out += b ? "true" : "false"; }
+
+inline void appendLogValue(std::string& out, const void* p)
+{
+    char buffer[2 + 2 * sizeof(p)] = { '0', 'x' };
+    auto result = std::to_chars(buffer + 2, buffer + sizeof(buffer), reinterpret_cast<std::uintptr_t>(p), 16);
+
+    out.append(buffer, result.ptr);
+}
+
+template<typename T>
+    requires std::is_arithmetic_v<T>
+void appendLogValue(std::string& out, T value)
+{
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+    out.append(buffer, result.ptr);
+}
+
+template<typename T>
+T loadLogArgument(const LogRecord& record, std::size_t& offset) noexcept
+{
+    T value;
+    std::memcpy(&value, record.payload + offset, sizeof(T));
+    offset += sizeof(T);
+
+    return value;
+}
+
+template<typename... Args>
+void formatLogRecord(std::string& out, const LogRecord& record)
+{
+    [[maybe_unused]] std::size_t offset = 0;
+
+    appendLogValue(out, record.timestamp);
+    out += " ns ";
+    out += record.message;
+    ((out += ' ', appendLogValue(out, loadLogArgument<Args>(record, offset))), ...);
+    out += '\n';
+}
+
+class LogRing
+{
+    public:
+        static constexpr std::size_t capacity = 16384;      // Records; a power of two
+
+        LogRing() : slots(std::make_unique<LogRecord[]>(capacity)) { }
+
+        // Owning thread: the next free record, or nullptr if the ring is full
+        LogRecord* claim() noexcept
+        {
+            auto t = tail.load(std::memory_order_relaxed);
+
+            if (t - cachedHead == capacity)
+            {
+                cachedHead = head.load(std::memory_order_acquire);
+
+                if (t - cachedHead == capacity)
+                {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+
+                    return nullptr;
+                }
+            }
+
+            return &slots[t & (capacity - 1)];
+        }
+
+        // Owning thread: make the claimed record visible to the flusher
+        void publish() noexcept
+        {
+            tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // Flusher: pass every published record to consume, then free their slots
+        template<typename Consume>
+        void drain(Consume consume)
+        {
+            auto h = head.load(std::memory_order_relaxed);
+            auto t = tail.load(std::memory_order_acquire);
+
+            for (; h != t; ++h)
+            {
+                consume(slots[h & (capacity - 1)]);
+            }
+
+            head.store(h, std::memory_order_release);
+        }
+
+        std::size_t takeDropped() noexcept { return dropped.exchange(0, std::memory_order_relaxed); }
+
+    private:
+        alignas(64) std::atomic<std::size_t> head { 0 };    // Written by the flusher
+        alignas(64) std::atomic<std::size_t> tail { 0 };    // Written by the owning thread, as are the next two
+        std::size_t cachedHead = 0;                         // Saves reading head on every claim
+        std::atomic<std::size_t> dropped { 0 };
+        std::unique_ptr<LogRecord[]> slots;
+};
+
+class AsyncLogger
+{
+    public:
+        static AsyncLogger& instance()
+        {
+            static AsyncLogger logger;
+
+            return logger;
+        }
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        ~AsyncLogger()
+        {
+            flusher.request_stop();
+            flusher.join();
+            flush();                                        // Whatever arrived after the last batch
+        }
+
+        void setSink(std::ostream& os)
+        {
+            std::lock_guard<std::mutex> g(mutex);
+            sink = &os;
+        }
+
+        // The calling thread's ring, registered on its first use; instance is the only AsyncLogger
+        LogRing& threadRing()
+        {
+            thread_local std::shared_ptr<LogRing> ring = [this]
+            {
+                auto r = std::make_shared<LogRing>();
+
+                std::lock_guard<std::mutex> g(mutex);
+                rings.push_back(r);
+
+                return r;
+            }();
+
+            return *ring;
+        }
+
+        void flush()
+        {
+            std::lock_guard<std::mutex> g(mutex);
+            flushLocked();
+        }
+
+    private:
+        static constexpr auto flushInterval = std::chrono::milliseconds(1);
+
+        AsyncLogger() : flusher([this](std::stop_token stop) { run(stop); }) { }
+
+        void run(std::stop_token stop)
+        {
+            std::unique_lock<std::mutex> lk(mutex);
+
+            while (!stop.stop_requested())
+            {
+                wake.wait_for(lk, stop, flushInterval, [] { return false; });
+                flushLocked();
+            }
+        }
+
+        void flushLocked()
+        {
+            batch.clear();
+
+            for (auto it = rings.begin(); it != rings.end(); )
+            {
+                // Only the flusher still refers to a ring whose thread has exited. Checked before draining, so a
+                // thread that exits midway is released next time, after its last records; the fence pairs with
+                // the thread's release of its reference, making those records visible to drain
+                auto& ring = *it;
+                bool exited = ring.use_count() == 1;
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                ring->drain([this](const LogRecord& record) { record.format(batch, record); });
+
+                if (auto n = ring->takeDropped())
+                {
+                    batch += "[";
+                    appendLogValue(batch, n);
+                    batch += " records dropped]\n";
+                }
+
+                it = exited ? rings.erase(it) : std::next(it);
+            }
+
+            if (!batch.empty())
+            {
+                sink->write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                sink->flush();
+            }
+        }
+
+        std::mutex mutex;                                   // Guards rings, sink and batch
+        std::condition_variable_any wake;
+        std::vector<std::shared_ptr<LogRing>> rings;
+        std::ostream* sink = &std::clog;
+        std::string batch;                                  // Reused, so flushing doesn't allocate once it's warm
+        std::jthread flusher;                               // Last, so everything it uses exists; see Item 37
+};
+
+template<typename Clock, typename Duration, typename... Args>
+void log(std::chrono::time_point<Clock, Duration> when, const char* message, Args... args)
+{
+    static_assert((std::is_trivially_copyable_v<Args> && ...), "log arguments are copied as bytes and formatted later");
+    static_assert((sizeof(Args) + ... + 0) <= LogRecord::payloadSize, "too many log arguments for one record");
+
+    auto& ring = AsyncLogger::instance().threadRing();
+    auto record = ring.claim();
+
+    if (!record)
+    {
+        return;                                             // Full; counted as dropped
+    }
+
+    [[maybe_unused]] std::size_t offset = 0;
+
+    record->timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+    record->message = message;
+    record->format = &formatLogRecord<Args...>;
+    ((std::memcpy(record->payload + offset, &args, sizeof(Args)), offset += sizeof(Args)), ...);
+
+    ring.publish();
+}
+
+template<typename... Args>
+void log(const char* message, Args... args)
+{
+    log(LogClock::now(), message, args...);
+}
+
+log(std::chrono::system_clock::now(), "logAndAdd");         // The book's call, unchanged
+log("addNames", 3);                                         // steady_clock timestamp; formatted on the flusher
+
+
+/**
+ * An Allocation-Free Registry:
+ * Forwarding "Patty Dog" into emplace avoids a temporary std::string, but the multiset still allocates a node and, past
+ * the small string buffer, a std::string for every insert, and a lookup with a const char* (names.count("Patty Dog"))
+ * builds a temporary std::string first, because std::multiset<std::string> uses std::less<std::string>.
+ *
+ * NameRegistry avoids both:
+ *
+ * - Every distinct name is copied once into a StringArena, which hands out std::string_views into large chunks. The
+ *   views stay valid for the life of the arena, because chunks are never reallocated.
+ *
+ * - The map is keyed by those views and counts duplicates, the way a multiset would. Its hash and equality are
+ *   transparent (is_transparent), so find and count accept std::string, std::string_view and const char* without
+ *   converting them to a key type that owns memory. Adding a name that's already present, and every lookup, allocate
+ *   nothing.
+ *
+ * - addNames takes a whole range and reserves once when it knows the range's size. Instead of a log entry per name, it
+ *   makes one entry per batch.
+*/
+class StringArena
+{
+    public:
+        static constexpr std::size_t chunkSize = 64 * 1024;
+
+        std::string_view intern(std::string_view s)
+        {
+            if (s.empty())
+            {
+                return { };
+            }
+
+            if (s.size() > chunkSize)
+            {
+                // Oversized strings get a chunk of their own, and the current chunk stays current
+                auto& own = chunks.emplace_back(std::make_unique<char[]>(s.size()));
+                std::memcpy(own.get(), s.data(), s.size());
+
+                return { own.get(), s.size() };
+            }
+
+            if (s.size() > chunkSize - used)
+            {
+                current = chunks.emplace_back(std::make_unique<char[]>(chunkSize)).get();
+                used = 0;
+            }
+
+            auto dest = current + used;
+            std::memcpy(dest, s.data(), s.size());
+            used += s.size();
+
+            return { dest, s.size() };
+        }
+
+    private:
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char* current = nullptr;        // Always a chunkSize chunk; oversized chunks never become current
+        std::size_t used = chunkSize;   // Forces a chunk on first use
+};
+
+struct TransparentStringHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view> { }(s); }
+};
+
+class NameRegistry
+{
+    public:
+        void add(std::string_view name)
+        {
+            if (auto it = counts.find(name); it != counts.end())
+            {
+                ++it->second;           // Already interned; no allocation
+            }
+            else
+            {
+                counts.emplace(arena.intern(name), 1);
+            }
+        }
+
+        template<std::ranges::input_range Range>
+        void addNames(Range&& range)
+        {
+            std::size_t added = 0;
+
+            if constexpr (std::ranges::sized_range<Range>)
+            {
+                counts.reserve(counts.size() + std::ranges::size(range));      // Upper bound: every name is new
+            }
+
+            for (auto&& name : range)
+            {
+                add(name);
+                ++added;
+            }
+
+            log(std::chrono::system_clock::now(), "addNames", added);           // One entry for the whole batch
+        }
+
+        template<typename Key>
+        std::size_t count(const Key& name) const
+        {
+            auto it = counts.find(name);
+
+            return it == counts.end() ? 0 : it->second;
+        }
+
+        std::size_t distinctNames() const noexcept { return counts.size(); }
+
+    private:
+        StringArena arena;
+        std::unordered_map<std::string_view, std::size_t, TransparentStringHash, std::equal_to<>> counts;
+};
+
+NameRegistry registry;
+
+registry.add("Patty Dog");                                  // Interned once
+registry.addNames(std::vector<const char*> { "Darla", "Persephone", "Patty Dog" });
+auto dogs = registry.count("Patty Dog");                    // 2; no temporary std::string
+
+
+/**
+ * Benchmarks:
+ * The cases add one name per iteration, drawn in turn from 100,000 distinct names of about 20 characters (see Item 24
+ * for registerBenchmark); std::multiset emplaces from a const char*, the way logAndAdd("Patty Dog") does. The multiset
+ * grows by one node per insert, while the registry only bumps a count once each name has been seen.
+ *
+ * reportNameInserts does the 10 million inserts in one go for each approach and prints the elapsed time and the number
+ * of stored nodes. Neither times log, which both would call.
+ *
+ * The log cases measure what the caller pays per entry: the asynchronous backend, against formatting the same record
+ * and writing it to a mutex-guarded std::ostringstream on the calling thread. The backend's sink is a stream without a
+ * buffer, which discards its output. When the flusher falls behind, a full ring drops records; that's the trade the
+ * backend makes to keep the caller from blocking.
+*/
+constexpr std::size_t distinctNameCount = 100'000;
+
+inline const std::vector<std::string>& benchNames()
+{
+    static const auto generated = []
+    {
+        std::vector<std::string> result;
+        result.reserve(distinctNameCount);
+
+        for (std::size_t i = 0; i < distinctNameCount; ++i)
+        {
+            result.push_back("registered-name-" + std::to_string(i));
+        }
+
+        return result;
+    }();
+
+    return generated;
+}
+
+inline void reportNameInserts(std::size_t insertCount = 10'000'000)
+{
+    const auto& pool = benchNames();
+
+    std::vector<const char*> batch;
+    batch.reserve(insertCount);
+
+    for (std::size_t i = 0; i < insertCount; ++i)
+    {
+        batch.push_back(pool[i % pool.size()].c_str());
+    }
+
+    auto time = [](const char* label, auto insertAll)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto stored = insertAll();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << label << ": " << elapsed.count() << " ms, " << stored << " nodes\n";
+    };
+
+    time("multiset<string>::emplace", [&]
+    {
+        std::multiset<std::string> set;
+
+        for (auto name : batch)
+        {
+            set.emplace(name);
+        }
+
+        return set.size();
+    });
+
+    time("NameRegistry::add", [&]
+    {
+        NameRegistry r;
+
+        for (auto name : batch)
+        {
+            r.add(name);
+        }
+
+        return r.distinctNames();
+    });
+
+    time("NameRegistry::addNames", [&]
+    {
+        NameRegistry r;
+        r.addNames(batch);
+
+        return r.distinctNames();
+    });
+}
+
+inline const bool item26Registered = []
+{
+    registerBenchmark("Item 26/add name, multiset<string>", []
+    {
+        static std::multiset<std::string> set;
+        static std::size_t next = 0;
+
+        set.emplace(benchNames()[next++ % distinctNameCount].c_str());
+
+        return set.size();
+    });
+
+    registerBenchmark("Item 26/add name, NameRegistry", []
+    {
+        static NameRegistry r;
+        static std::size_t next = 0;
+
+        r.add(benchNames()[next++ % distinctNameCount].c_str());
+
+        return r.distinctNames();
+    });
+
+    registerBenchmark("Item 26/lookup by const char*, multiset<string>", []
+    {
+        static const std::multiset<std::string> set(benchNames().begin(), benchNames().end());
+
+        return set.count("registered-name-4242");
+    });
+
+    registerBenchmark("Item 26/lookup by const char*, NameRegistry", []
+    {
+        static const auto r = []
+        {
+            NameRegistry result;
+            result.addNames(benchNames());
+
+            return result;
+        }();
+
+        return r.count("registered-name-4242");
+    });
+
+    static std::ostream discard(nullptr);
+    AsyncLogger::instance().setSink(discard);
+
+    // Few enough calls that the ring never fills even if the flusher never ran, so every call is timed storing a
+    // record rather than counting a drop; the synchronous case uses the same options to stay comparable
+    constexpr BenchmarkOptions logBenchmark { 10, 101, 128 };
+    static_assert(logBenchmark.warmupRuns + logBenchmark.samples * logBenchmark.iterationsPerSample
+                  <= LogRing::capacity);
+
+    registerBenchmark("Item 26/log call, AsyncLogger", []
+    {
+        static std::size_t next = 0;
+
+        log("logAndAdd", next++);
+
+        return next;
+    }, logBenchmark);
+
+    registerBenchmark("Item 26/log call, synchronous", []
+    {
+        static std::mutex m;
+        static std::ostringstream out;
+        static std::string line;
+        static std::size_t next = 0;
+
+        LogRecord record { LogClock::now().time_since_epoch().count(), "logAndAdd", nullptr, { } };
+        std::memcpy(record.payload, &next, sizeof(next));
+        ++next;
+
+        std::lock_guard<std::mutex> g(m);
+
+        line.clear();
+        formatLogRecord<std::size_t>(line, record);
+        out << line;
+
+        if (out.tellp() > 1 << 20)
+        {
+            out.str({ });                                   // Stand-in for writing the stream out
+        }
+
+        return next;
+    }, logBenchmark);
+
+    return true;
+}();
+
+reportNameInserts();
@@ -1,4 +1,14 @@
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
 /**
  * Familiarize yourself with alternatives to overloading on universal references.
  *
@@ -94,6 +104,259 @@ class Person
 };
 
 
+/**
+ * Names Without a std::string:
+ * Every constructor above ends by building a std::string, so a name longer than the small string buffer costs an
+ * allocation per Person even when the caller passed a literal or a std::string_view. PersonName stores up to 23
+ * characters inline and interns anything longer, once per distinct name, into a StringArena from Item 26. Interned
+ * names live as long as the program, which suits the bounded set of names a program typically sees; copying a
+ * PersonName never allocates.
+ *
+ * The constructors are split by concepts instead of tag types or enable_if:
+ *
+ * - StringLiteral matches arrays of const char. The extent bounds the search for the terminator, so a partly filled
+ *   array such as const char buf[32] = "Bob" gives three characters, not 31, and one without a terminator gives all
+ *   of them. For a literal the search is over a constant, which the compiler folds away once the call is inlined.
+ *
+ * - StringViewLike matches everything else that converts to std::string_view: std::string, std::string_view and
+ *   const char*. It never builds a std::string.
+ *
+ * - OtherNameSource matches whatever else a std::string can be constructed from, and builds one. It excludes the two
+ *   cases above, so no call is ambiguous. Person and integral types aren't string sources, so unlike Constraint, whose
+ *   T is a reference type for lvalues, it never captures the copy constructor's arguments (see Item 26).
+*/
+// Interns names too long for PersonName's buffer (see Item 26 for StringArena and TransparentStringHash)
+inline std::string_view internName(std::string_view s)
+{
+    static std::mutex m;
+    static StringArena arena;
+    static std::unordered_set<std::string_view, TransparentStringHash, std::equal_to<>> names;
+
+    std::lock_guard<std::mutex> g(m);
+
+    if (auto it = names.find(s); it != names.end())
+    {
+        return *it;
+    }
+
+    return *names.insert(arena.intern(s)).first;
+}
+
+class PersonName
+{
+    public:
+        static constexpr std::size_t inlineCapacity = 23;
+
+        explicit PersonName(std::string_view s)
+            : length(s.size())
+        {
+            if (s.size() <= inlineCapacity)
+            {
+                std::memcpy(buffer, s.data(), s.size());
+            }
+            else
+            {
+                external = internName(s).data();
+            }
+        }
+
+        std::string_view view() const noexcept { return { external ? external : buffer, length }; }
+
+    private:
+        const char* external = nullptr;             // Interned characters; nullptr when they're in buffer
+        std::size_t length;
+        char buffer[inlineCapacity] { };
+};
+
+template<typename T>
+concept StringLiteral = std::is_bounded_array_v<std::remove_reference_t<T>>
+                        && std::same_as<std::remove_extent_t<std::remove_reference_t<T>>, const char>;
+
+template<typename T>
+concept StringViewLike = !StringLiteral<T> && std::convertible_to<T, std::string_view>;
+
+template<typename T>
+concept OtherNameSource = !StringLiteral<T> && !StringViewLike<T> && std::constructible_from<std::string, T>;
+
+// The characters before the first null, never reading past the array
+template<std::size_t N>
+constexpr std::string_view boundedView(const char (&chars)[N]) noexcept
+{
+    auto terminator = std::char_traits<char>::find(chars, N, '\0');
+
+    return { chars, terminator ? static_cast<std::size_t>(terminator - chars) : N };
+}
+
+// C++20, without a std::string per Person
+class Person
+{
+    public:
+        template<typename T>
+            requires StringLiteral<T>
+        explicit Person(T&& literal)                // Length bounded by the type
+            : name(boundedView(literal)) { }
+
+        template<typename T>
+            requires StringViewLike<T>
+        explicit Person(T&& n)                      // std::string, std::string_view, const char*
+            : name(std::string_view(n)) { }
+
+        template<typename T>
+            requires OtherNameSource<T>
+        explicit Person(T&& n)                      // Anything else convertible to std::string
+            : name(std::string(std::forward<T>(n))) { }
+
+        explicit Person(int idx)
+            : name(nameFromIdx(idx)) { }
+
+        std::string_view getName() const noexcept { return name.view(); }
+
+    private:
+        PersonName name;
+};
+
+Person p1("Nancy");                                 // StringLiteral: copied into the inline buffer
+Person p2(std::string_view("Sir Reginald Wellington-Smythe"));  // StringViewLike: interned, no std::string
+
+
+/**
+ * Compile-Time Cost:
+ * Each way of constraining a universal reference instantiates something per distinct argument type:
+ *
+ * - Tag dispatch: the forwarding function, its Impl, std::remove_reference and std::is_integral. Two function templates
+ *   and two class templates.
+ *
+ * - enable_if: the constructor, std::decay, std::is_base_of, std::remove_reference and std::is_integral, and
+ *   std::enable_if<true> once for all types. One function template and four class templates.
+ *
+ * - Concepts: the constructor plus the same traits, reached through std::derived_from and std::integral, and a
+ *   satisfaction check per concept, which the compiler caches per type. One function template and four or five class
+ *   templates.
+ *
+ * writeConstraintCostTU generates the measurement: one translation unit per style, each constructing a Person from
+ * 2,000 distinct argument types convertible to std::string, plus an unconstrained baseline that is just the calls. Time
+ * each with g++ -std=c++20 -fsyntax-only (or add -ftime-report for GCC, -ftime-trace for Clang) and divide the
+ * difference from the baseline by 2,000 to get each style's cost per argument type. traitConcepts spells the concept
+ * with std::is_base_of_v and std::is_integral_v instead of std::derived_from and std::integral, to show what the
+ * standard concepts add. Expect every style's cost to be small next to the baseline's, which includes building the
+ * std::string in each constructor. Expect the differences between styles to be small too, and to change with the
+ * compiler and its version, so run several times before ranking them. If they're within noise, choose by diagnostics
+ * and readability, not build time.
+*/
+enum class ConstraintStyle { unconstrained, tagDispatch, enableIf, concepts, traitConcepts };
+
+constexpr std::string_view toString(ConstraintStyle style)
+{
+    switch (style)
+    {
+        case ConstraintStyle::unconstrained:    return "unconstrained";
+        case ConstraintStyle::tagDispatch:      return "tag-dispatch";
+        case ConstraintStyle::enableIf:         return "enable-if";
+        case ConstraintStyle::concepts:         return "concepts";
+        case ConstraintStyle::traitConcepts:    return "trait-concepts";
+    }
+
+    return "?";
+}
+
+// Writes a translation unit that constructs a Person, constrained as style says, from each of typeCount distinct
+// types convertible to std::string. The unconstrained version is the baseline: the calls alone
+inline void writeConstraintCostTU(std::ostream& out, ConstraintStyle style, std::size_t typeCount)
+{
+    out << "#include <concepts>\n#include <string>\n#include <type_traits>\n#include <utility>\n\n"
+        << "template<int N> struct Source { operator std::string() const { return \"name\"; } };\n\n";
+
+    switch (style)
+    {
+        case ConstraintStyle::unconstrained:
+            out << "struct Person\n{\n"
+                << "    template<typename T> explicit Person(T&& n) : name(std::forward<T>(n)) { }\n";
+            break;
+
+        case ConstraintStyle::tagDispatch:
+            out << "struct Person\n{\n"
+                << "    template<typename T> explicit Person(T&& n)\n"
+                << "        : Person(std::forward<T>(n), std::is_integral<std::remove_reference_t<T>>()) { }\n"
+                << "    template<typename T> Person(T&& n, std::false_type) : name(std::forward<T>(n)) { }\n"
+                << "    Person(int idx, std::true_type);\n";
+            break;
+
+        case ConstraintStyle::enableIf:
+            out << "struct Person\n{\n"
+                << "    template<typename T,\n"
+                << "             typename = std::enable_if_t<\n"
+                << "                 !std::is_base_of<Person, std::decay_t<T>>::value &&\n"
+                << "                 !std::is_integral<std::remove_reference_t<T>>::value>>\n"
+                << "    explicit Person(T&& n) : name(std::forward<T>(n)) { }\n";
+            break;
+
+        case ConstraintStyle::concepts:
+            out << "struct Person;\n"
+                << "template<typename T>\n"
+                << "concept Constraint = !std::derived_from<T, Person> && !std::integral<T>;\n"
+                << "struct Person\n{\n"
+                << "    template<typename T> requires Constraint<T>\n"
+                << "    explicit Person(T&& n) : name(std::forward<T>(n)) { }\n";
+            break;
+
+        case ConstraintStyle::traitConcepts:
+            out << "struct Person;\n"
+                << "template<typename T>\n"
+                << "concept Constraint = !std::is_base_of_v<Person, T> && !std::is_integral_v<T>;\n"
+                << "struct Person\n{\n"
+                << "    template<typename T> requires Constraint<T>\n"
+                << "    explicit Person(T&& n) : name(std::forward<T>(n)) { }\n";
+            break;
+    }
+
+    out << "    explicit Person(int idx);\n    std::string name;\n};\n\n";
+
+    for (std::size_t i = 0; i < typeCount; ++i)
+    {
+        out << "void call" << i << "() { Person p(Source<" << i << "> { }); }\n";
+    }
+}
+
+for (auto style : { ConstraintStyle::unconstrained, ConstraintStyle::tagDispatch, ConstraintStyle::enableIf,
+                    ConstraintStyle::concepts, ConstraintStyle::traitConcepts })
+{
+    std::ofstream out("item27-" + std::string(toString(style)) + ".cpp");
+    writeConstraintCostTU(out, style, 2'000);
+}
+
+
+/**
+ * Benchmarks:
+ * Each case constructs a name from the same std::string_view (see Item 24 for registerBenchmark). At 8 characters both
+ * fit in their inline buffers, so expect both to cost a copy of the characters and little else. At 40, std::string
+ * allocates every time and PersonName hashes the name, locks and finds it interned. In a single-threaded loop, where
+ * malloc hands back the block just freed, expect neither to win clearly. For long names PersonName's gain is memory:
+ * one copy per distinct name instead of one per Person.
+*/
+inline const bool item27Registered = []
+{
+    for (std::size_t length : { 8, 40 })
+    {
+        const auto suffix = ", " + std::to_string(length) + " chars";
+
+        registerBenchmark("Item 27/std::string" + suffix, [s = std::string(length, 'x')]
+        {
+            std::string name(std::string_view { s });
+
+            return name.size();
+        });
+
+        registerBenchmark("Item 27/PersonName" + suffix, [s = std::string(length, 'x')]
+        {
+            PersonName name(s);
+
+            return name.view().size();
+        });
+    }
+
+    return true;
+}();
+
 /**
  * Static Asserts:
  * To enhance error clarity and enforce constraints, static_assert with std::is_constructible can be used
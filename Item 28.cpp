@@ -67,3 +67,18 @@ void f(T&& fParam)
  *  3. Creation or evaluation of typedefs and alias declarations.
  *  4. Uses of `decltype`.
 */
+
+
+/**
+ * Reference Collapsing in an Emplace Queue:
+ * Item 30's EmplaceQueue::emplace takes Args&&... and forwards each argument into placement new. For an lvalue
+ * std::string argument Args is deduced as std::string&, and std::string& && collapses to std::string&, so the string in
+ * the slot is copy constructed. For an rvalue Args is std::string, the parameter is std::string&&, and std::forward
+ * casts it back to an rvalue, so the string in the slot is move constructed. Either way no temporary is made.
+*/
+EmplaceQueue<std::string> topics;
+std::string topic = "orders";
+
+topics.emplace(topic);                      // Args is std::string&; parameter is std::string&
+topics.emplace(std::move(topic));           // Args is std::string; parameter is std::string&&
+topics.emplace(8, 'x');                     // Args are int, char; std::string(8, 'x') is built in the slot
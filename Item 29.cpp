@@ -1,3 +1,17 @@
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 /**
  * Assume that move operations are not present, not cheap, and not used.
  *
@@ -39,4 +53,199 @@
  * not usable, developers must remain cautious about object copying, just as in pre-C++11 code. Understanding the
  * specifics of how types are implemented and used is crucial to fully leverage the potential performance gains offered
  * by move semantics.
-*/
\ No newline at end of file
+*/
+
+
+/**
+ * Knowing Instead of Assuming:
+ * The advice to assume moves are absent, expensive and unused is for code that can't know the types involved. Where the
+ * types are known, the three questions can be answered for them, at compile time where possible:
+ *
+ * - Is the move noexcept? If not, std::vector and friends copy instead (see Item 14), so in containers the move might as
+ *   well not exist.
+ *
+ * - Is the type trivially relocatable, i.e. can a move followed by destruction of the source be done with memcpy? Then
+ *   a container can grow by copying raw bytes.
+ *
+ * - How does the move's cost grow? Constant for types that own their contents through a pointer (vector, deque, list,
+ *   map, unordered_map, heap strings), but linear in the element count for std::array, and bounded-but-not-free for
+ *   strings that fit the small string buffer. For any other type the trait says unknown: a user-defined move may
+ *   do anything, so constant is claimed only for the standard types known to steal a pointer.
+*/
+enum class MoveCost
+{
+    trivial,            // Copies sizeof(T) bytes; nothing else to do
+    constant,           // Steals a pointer (or a few), independent of the contents
+    bounded,            // Copies an inline buffer of bounded size, e.g. an SSO string
+    linear,             // Moves every element, e.g. std::array
+    unknown             // Not trivially copyable and not specialized below
+};
+
+template<typename T>
+struct MoveCostOf
+{
+    static constexpr MoveCost value = std::is_trivially_copyable_v<T> ? MoveCost::trivial : MoveCost::unknown;
+};
+
+template<MoveCost Cost>
+struct MoveCostIs
+{
+    static constexpr MoveCost value = Cost;
+};
+
+// Types that own their contents through a pointer; a move steals it
+
+template<typename T, typename Alloc>
+struct MoveCostOf<std::vector<T, Alloc>> : MoveCostIs<MoveCost::constant> { };
+
+template<typename T, typename Alloc>
+struct MoveCostOf<std::deque<T, Alloc>> : MoveCostIs<MoveCost::constant> { };
+
+template<typename T, typename Alloc>
+struct MoveCostOf<std::list<T, Alloc>> : MoveCostIs<MoveCost::constant> { };
+
+template<typename K, typename V, typename Compare, typename Alloc>
+struct MoveCostOf<std::map<K, V, Compare, Alloc>> : MoveCostIs<MoveCost::constant> { };
+
+template<typename K, typename V, typename Hash, typename Eq, typename Alloc>
+struct MoveCostOf<std::unordered_map<K, V, Hash, Eq, Alloc>> : MoveCostIs<MoveCost::constant> { };
+
+template<typename T, typename Deleter>
+struct MoveCostOf<std::unique_ptr<T, Deleter>> : MoveCostIs<MoveCost::constant> { };
+
+template<typename T>
+struct MoveCostOf<std::shared_ptr<T>> : MoveCostIs<MoveCost::constant> { };
+
+template<typename T, std::size_t N>
+struct MoveCostOf<std::array<T, N>>
+{
+    static constexpr MoveCost value = std::is_trivially_copyable_v<T> ? MoveCost::trivial : MoveCost::linear;
+};
+
+// Constant when the string is on the heap; a short string's characters are copied out of its inline buffer
+template<typename CharT, typename Traits, typename Alloc>
+struct MoveCostOf<std::basic_string<CharT, Traits, Alloc>>
+{
+    static constexpr MoveCost value = MoveCost::bounded;
+};
+
+
+/**
+ * Trivial Relocation:
+ * The language can only prove relocatability for trivially copyable types. Many others are relocatable in practice
+ * (std::vector, std::unique_ptr, std::string in libc++ but not in libstdc++, whose SSO string points into itself), so
+ * the trait is an opt-in: specialize IsTriviallyRelocatable for a type whose move-plus-destroy is a byte copy in every
+ * implementation you ship on.
+*/
+template<typename T>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>> { };
+
+template<typename T, typename Alloc>
+struct IsTriviallyRelocatable<std::vector<T, Alloc>> : std::true_type { };
+
+template<typename T>
+inline constexpr bool isTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+template<typename T>
+struct MoveTraits
+{
+    static constexpr bool movable = std::is_move_constructible_v<T>;
+    static constexpr bool nothrowMove = std::is_nothrow_move_constructible_v<T>;
+    static constexpr bool triviallyRelocatable = isTriviallyRelocatable<T>;
+    static constexpr MoveCost cost = MoveCostOf<T>::value;
+
+    // What std::vector's reallocation will actually do with a T (see Item 14 for std::move_if_noexcept)
+    static constexpr bool vectorGrowthMoves = nothrowMove || !std::is_copy_constructible_v<T>;
+};
+
+static_assert(MoveTraits<std::array<std::string, 100>>::cost == MoveCost::linear);
+static_assert(MoveTraits<std::vector<std::string>>::cost == MoveCost::constant);
+static_assert(MoveTraits<std::vector<std::string>>::triviallyRelocatable);
+
+
+/**
+ * Run-Time Report:
+ * reportMoveTraits prints the compile-time answers next to sizeof, which is the byte count a trivial or bounded move
+ * copies. The name is passed in; see Item 4 for why typeid(T).name() is no substitute.
+*/
+constexpr std::string_view toString(MoveCost cost)
+{
+    switch (cost)
+    {
+        case MoveCost::trivial:     return "trivial (byte copy)";
+        case MoveCost::constant:    return "O(1)";
+        case MoveCost::bounded:     return "O(1), copies inline buffer";
+        case MoveCost::linear:      return "O(n) in elements";
+        case MoveCost::unknown:     return "unknown";
+    }
+
+    return "?";
+}
+
+template<typename T>
+void reportMoveTraits(std::string_view name)
+{
+    using Traits = MoveTraits<T>;
+
+    std::cout << name << ": sizeof " << sizeof(T)
+              << ", noexcept move " << (Traits::nothrowMove ? "yes" : "no")
+              << ", trivially relocatable " << (Traits::triviallyRelocatable ? "yes" : "no")
+              << ", move cost " << toString(Traits::cost)
+              << ", vector growth " << (Traits::vectorGrowthMoves ? "moves" : "copies") << '\n';
+}
+
+reportMoveTraits<std::array<int, 1000>>("std::array<int, 1000>");
+reportMoveTraits<std::array<std::string, 100>>("std::array<std::string, 100>");
+reportMoveTraits<std::string>("std::string");
+reportMoveTraits<std::vector<int>>("std::vector<int>");
+reportMoveTraits<std::deque<int>>("std::deque<int>");                  // libstdc++ deque's move ctor isn't noexcept
+reportMoveTraits<std::list<int>>("std::list<int>");
+reportMoveTraits<std::map<int, int>>("std::map<int, int>");
+reportMoveTraits<std::unordered_map<int, int>>("std::unordered_map<int, int>");
+
+
+/**
+ * Benchmarks:
+ * MoveCost describes move construction, so that's what each case times: it constructs a second object from the value,
+ * destroys the source and constructs the value back, two constructions per iteration (see Item 24 for
+ * registerBenchmark). Move assignment would also free whatever the target held, which is a different cost. std::array
+ * scales with its size, an SSO string costs about as much as copying it, a heap string and every vector cost the same
+ * few nanoseconds whatever they hold. The copy cases are the baseline the moves should be compared with.
+*/
+template<typename T>
+void registerMoveBenchmarks(const std::string& name, T value)
+{
+    registerBenchmark("Item 29/move " + name, [a = std::optional<T>(value), b = std::optional<T>()]() mutable
+    {
+        b.emplace(std::move(*a));
+        a.reset();
+        a.emplace(std::move(*b));
+        b.reset();
+
+        return &a;
+    });
+
+    registerBenchmark("Item 29/copy " + name, [a = std::optional<T>(value), b = std::optional<T>()]() mutable
+    {
+        b.emplace(*a);
+        a.reset();
+        a.emplace(*b);
+        b.reset();
+
+        return &a;
+    });
+}
+
+inline const bool item29Registered = []
+{
+    registerMoveBenchmarks("std::array<int, 16>", std::array<int, 16> { });
+    registerMoveBenchmarks("std::array<int, 1024>", std::array<int, 1024> { });
+    registerMoveBenchmarks("std::array<std::string, 64>", std::array<std::string, 64> { });
+    registerMoveBenchmarks("std::string, 8 chars (SSO)", std::string(8, 'x'));
+    registerMoveBenchmarks("std::string, 64 chars (heap)", std::string(64, 'x'));
+    registerMoveBenchmarks("std::vector<int>, 1024", std::vector<int>(1024));
+    registerMoveBenchmarks("std::vector<std::string>, 1024", std::vector<std::string>(1024, std::string(64, 'x')));
+    registerMoveBenchmarks("std::vector<std::array<int, 64>>, 1024", std::vector<std::array<int, 64>>(1024));
+
+    return true;
+}();
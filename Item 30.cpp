@@ -1,3 +1,17 @@
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 /**
  * Familiarize yourself with perfect forwarding failure cases.
@@ -136,6 +150,477 @@ auto length = static_cast<std::uint16_t>(h.totalLength);
 
 fwd(length);                // Forward the copy
 
+
+/**
+ * Reading Headers Without Bitfields:
+ * IPv4Header has a second problem besides forwarding: bitfield layout is implementation-defined, and the header arrives
+ * in network byte order. With GCC or Clang on a little-endian machine, version lands in the low nibble of the first
+ * byte, where the wire format puts IHL, and totalLength comes out byte-swapped. So a packet has to be copied into the
+ * struct and then fixed up.
+ *
+ * IPv4HeaderView reads the fields straight from the packet bytes with shifts, which gives the same answer on every
+ * compiler and byte order. It doesn't copy the packet, and every accessor returns an ordinary integer prvalue, so
+ * fwd(view.totalLength()) just works. Everything is constexpr, so a header can be checked at compile time.
+*/
+class IPv4HeaderView
+{
+    public:
+        static constexpr std::size_t minSize = 20;              // IHL of 5, no options
+
+        // bytes must hold at least minSize bytes; see valid
+        constexpr explicit IPv4HeaderView(std::span<const std::byte> bytes) noexcept : bytes(bytes) { }
+
+        constexpr std::uint8_t version() const noexcept { return byteAt(0) >> 4; }
+        constexpr std::uint8_t IHL() const noexcept { return byteAt(0) & 0x0F; }
+        constexpr std::uint8_t DSCP() const noexcept { return byteAt(1) >> 2; }
+        constexpr std::uint8_t ECN() const noexcept { return byteAt(1) & 0x03; }
+
+        constexpr std::uint16_t totalLength() const noexcept
+        {
+            return static_cast<std::uint16_t>((byteAt(2) << 8) | byteAt(3));        // Big-endian on the wire
+        }
+
+        constexpr std::size_t headerSize() const noexcept { return std::size_t { IHL() } * 4; }
+
+        constexpr bool valid() const noexcept
+        {
+            return bytes.size() >= minSize && version() == 4 && IHL() >= 5 && headerSize() <= bytes.size();
+        }
+
+    private:
+        constexpr std::uint8_t byteAt(std::size_t i) const noexcept { return std::to_integer<std::uint8_t>(bytes[i]); }
+
+        std::span<const std::byte> bytes;
+};
+
+// Version 4, IHL 5, DSCP 46 (expedited forwarding), ECN 1, total length 1500
+constexpr std::array<std::byte, IPv4HeaderView::minSize> sampleHeader
+{
+    std::byte { 0x45 }, std::byte { 0xB9 }, std::byte { 0x05 }, std::byte { 0xDC }
+};
+
+static_assert(IPv4HeaderView(sampleHeader).version() == 4);
+static_assert(IPv4HeaderView(sampleHeader).DSCP() == 46);
+static_assert(IPv4HeaderView(sampleHeader).ECN() == 1);
+static_assert(IPv4HeaderView(sampleHeader).totalLength() == 1500);
+
+IPv4HeaderView view(packetBytes);
+
+fwd(view.totalLength());                                // Fine, no bitfield and no copy to make
+
+
+/**
+ * Batch Decoding from a Capture Ring:
+ * PacketRing is laid out like a capture buffer: fixed-size slots, each holding the first slotSize bytes of a packet (a
+ * pcap snap length), in a power-of-two ring. Because slots never wrap, each header is contiguous and can be viewed in
+ * place. decodeBatch walks count slots starting at first, skips anything that isn't a well-formed IPv4 header, and
+ * writes the fields the caller needs into out. It returns the number of headers written.
+*/
+struct DecodedHeader
+{
+    std::uint8_t DSCP;
+    std::uint8_t ECN;
+    std::uint16_t totalLength;
+};
+
+class PacketRing
+{
+    public:
+        static constexpr std::size_t slotSize = 64;
+
+        // slotCount must be a power of two
+        explicit PacketRing(std::size_t slotCount) : mask(slotCount - 1), storage(slotCount * slotSize) { }
+
+        // Copy up to slotSize bytes of a packet into slot index (modulo the ring size)
+        void store(std::size_t index, std::span<const std::byte> packet) noexcept
+        {
+            auto slot = slotBytes(index);
+            auto n = packet.size() < slotSize ? packet.size() : slotSize;
+
+            std::memcpy(slot.data(), packet.data(), n);
+            std::memset(slot.data() + n, 0, slotSize - n);
+        }
+
+        std::span<const std::byte, slotSize> slot(std::size_t index) const noexcept
+        {
+            return std::span<const std::byte, slotSize>(storage.data() + (index & mask) * slotSize, slotSize);
+        }
+
+        std::size_t size() const noexcept { return mask + 1; }
+
+    private:
+        std::span<std::byte, slotSize> slotBytes(std::size_t index) noexcept
+        {
+            return std::span<std::byte, slotSize>(storage.data() + (index & mask) * slotSize, slotSize);
+        }
+
+        std::size_t mask;
+        std::vector<std::byte> storage;
+};
+
+inline std::size_t decodeBatch(const PacketRing& ring, std::size_t first, std::size_t count,
+                               std::span<DecodedHeader> out) noexcept
+{
+    std::size_t decoded = 0;
+
+    for (std::size_t i = 0; i < count && decoded < out.size(); ++i)
+    {
+        IPv4HeaderView header(ring.slot(first + i));
+
+        if (header.valid())
+        {
+            out[decoded++] = { header.DSCP(), header.ECN(), header.totalLength() };
+        }
+    }
+
+    return decoded;
+}
+
+
+/**
+ * Benchmarks:
+ * A ring of 4,096 captured packets, decoded in one batch per iteration (see Item 24 for registerBenchmark). The
+ * bitfield case does what IPv4Header forces on real packets: memcpy each header into the struct, then swap
+ * totalLength's bytes. Even then its version and IHL are only right on compilers whose bitfield layout happens to
+ * match the wire format, which is why it checks the first byte directly. The view case reads the same fields in place.
+*/
+constexpr std::size_t ringSlots = 4096;
+
+inline const bool item30Registered = []
+{
+    static PacketRing ring(ringSlots);
+    static std::vector<DecodedHeader> decoded(ringSlots);
+
+    for (std::size_t i = 0; i < ringSlots; ++i)
+    {
+        auto packet = sampleHeader;
+        auto length = static_cast<std::uint16_t>(20 + i % 1480);
+
+        packet[1] = std::byte { static_cast<unsigned char>(i & 0xFF) };
+        packet[2] = std::byte { static_cast<unsigned char>(length >> 8) };
+        packet[3] = std::byte { static_cast<unsigned char>(length & 0xFF) };
+
+        if (i % 64 == 0)
+        {
+            packet[0] = std::byte { 0x60 };                     // The odd IPv6 packet, which decoding skips
+        }
+
+        ring.store(i, packet);
+    }
+
+    registerBenchmark("Item 30/decode ring, bitfield struct", []
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < ringSlots; ++i)
+        {
+            auto slot = ring.slot(i);
+
+            if (std::to_integer<std::uint8_t>(slot[0]) >> 4 != 4)
+            {
+                continue;
+            }
+
+            IPv4Header h;
+            std::memcpy(&h, slot.data(), sizeof(h));
+
+            auto length = static_cast<std::uint16_t>(h.totalLength);
+            decoded[count++] = { static_cast<std::uint8_t>(h.DSCP), static_cast<std::uint8_t>(h.ECN),
+                                 static_cast<std::uint16_t>((length >> 8) | (length << 8)) };
+        }
+
+        return count;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 30/decode ring, IPv4HeaderView", []
+    {
+        return decodeBatch(ring, 0, ringSlots, decoded);
+    }, batchBenchmark);
+
+    return true;
+}();
+
+
+/**
+ * An Emplace Queue:
+ * Our message queue used to take a finished message: producers built a temporary and the queue moved it into a slot.
+ * EmplaceQueue takes the constructor arguments instead, and emplace forwards them into the slot's raw storage with
+ * placement new, so each message is constructed exactly once, where the consumer will read it.
+ *
+ * It's a bounded multi-producer, single-consumer ring. Each slot carries a sequence number: a producer claims the slot
+ * whose sequence equals the tail by advancing the tail with a compare-exchange, constructs the message, and publishes
+ * it by storing sequence + 1. The consumer takes slots whose sequence is one past its head, and hands them back to
+ * producers by storing head + capacity. If a constructor throws, the slot is still published, marked empty, so the
+ * consumer never waits on it; the exception then propagates to the producer.
+ *
+ * The only forwarding failure emplace can fix itself is the braced initializer: like std::optional::emplace, it has an
+ * overload whose first parameter is a std::initializer_list, which braces can initialize. The others are fixed at the
+ * call site with the adapters further down.
+*/
+template<typename T>
+class EmplaceQueue
+{
+    public:
+        explicit EmplaceQueue(std::size_t capacity = 1024)         // Rounded up to a power of two
+            : slots(std::bit_ceil(capacity)), mask(slots.size() - 1)
+        {
+            for (std::size_t i = 0; i < slots.size(); ++i)
+            {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~EmplaceQueue()
+        {
+            drain([](T&&) { });                                 // Destroy whatever the consumer didn't take
+        }
+
+        EmplaceQueue(const EmplaceQueue&) = delete;
+        EmplaceQueue& operator=(const EmplaceQueue&) = delete;
+
+        // Returns false, constructing nothing, if the ring is full
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        bool tryEmplace(Args&&... args)
+        {
+            return publish([&](void* storage) { ::new (storage) T(std::forward<Args>(args)...); });
+        }
+
+        template<typename U, typename... Args>
+            requires std::constructible_from<T, std::initializer_list<U>&, Args...>
+        bool tryEmplace(std::initializer_list<U> il, Args&&... args)
+        {
+            return publish([&](void* storage) { ::new (storage) T(il, std::forward<Args>(args)...); });
+        }
+
+        // Spins (yielding) while the ring is full
+        template<typename... Args>
+            requires std::constructible_from<T, Args...>
+        void emplace(Args&&... args)
+        {
+            while (!tryEmplace(std::forward<Args>(args)...))    // Nothing is moved from when tryEmplace fails
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        template<typename U, typename... Args>
+            requires std::constructible_from<T, std::initializer_list<U>&, Args...>
+        void emplace(std::initializer_list<U> il, Args&&... args)
+        {
+            while (!tryEmplace(il, std::forward<Args>(args)...))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // Consumer only: calls consume(T&&) on every published message, in order, and returns how many it took
+        template<typename Consume>
+        std::size_t drain(Consume&& consume)
+        {
+            std::size_t count = 0;
+
+            for (;; ++head)
+            {
+                Slot& slot = slots[head & mask];
+
+                if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+                {
+                    return count;
+                }
+
+                if (slot.engaged)
+                {
+                    T* message = std::launder(reinterpret_cast<T*>(slot.storage));
+
+                    consume(std::move(*message));
+                    message->~T();
+                    ++count;
+                }
+
+                slot.sequence.store(head + slots.size(), std::memory_order_release);
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<std::size_t> sequence;
+            bool engaged;                                       // Written by the producer before it publishes
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        template<typename Construct>
+        bool publish(Construct construct)
+        {
+            auto pos = tail.load(std::memory_order_relaxed);
+            Slot* slot;
+
+            for (;;)
+            {
+                slot = &slots[pos & mask];
+                const auto sequence = slot->sequence.load(std::memory_order_acquire);
+
+                if (sequence == pos)
+                {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;                                  // The slot is ours
+                    }
+                }
+                else if (sequence < pos)
+                {
+                    return false;                               // The consumer hasn't freed it yet: full
+                }
+                else
+                {
+                    pos = tail.load(std::memory_order_relaxed); // Another producer got there first
+                }
+            }
+
+            try
+            {
+                construct(slot->storage);
+                slot->engaged = true;
+            }
+            catch (...)
+            {
+                slot->engaged = false;
+                slot->sequence.store(pos + 1, std::memory_order_release);
+                throw;
+            }
+
+            slot->sequence.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        std::vector<Slot> slots;
+        std::size_t mask;
+        alignas(64) std::atomic<std::size_t> tail { 0 };        // Shared by producers
+        alignas(64) std::size_t head = 0;                       // Consumer only; a cache line away from tail
+};
+
+
+/**
+ * Adapters for the Failure Cases:
+ * emplace forwards like fwd, so it fails on the same arguments. What each one needs at the call site:
+ *
+ * - Braced initializers: the std::initializer_list overload takes them directly.
+ *
+ * - 0 or NULL: nullptr, which forwards as std::nullptr_t. The requires clause turns the int that 0 deduces to into a
+ *   constraint failure at the call, instead of an error deep inside placement new.
+ *
+ * - Declaration-only static const members, and bitfields: valueOf copies the value into a prvalue. Its parameter is a
+ *   value, not a reference, so MinVals isn't odr-used (nothing needs its address) and a bitfield can initialize it.
+ *
+ * - Overloaded names and templates: selectOverload<Signature> picks the function with that signature, the way the
+ *   static_cast above does, without spelling out a pointer type.
+*/
+template<typename T>
+constexpr T valueOf(T value) noexcept
+{
+    return value;
+}
+
+template<typename Signature>
+constexpr Signature* selectOverload(Signature* f) noexcept
+{
+    return f;
+}
+
+struct Message
+{
+    Message(std::string topic, std::uint16_t length, int (*handler)(int), const std::vector<int>* extra)
+        : topic(std::move(topic)), length(length), handler(handler), extra(extra) { }
+
+    Message(std::initializer_list<int> ids, std::string topic) : ids(ids), topic(std::move(topic)) { }
+
+    std::vector<int> ids;
+    std::string topic;
+    std::uint16_t length = 0;
+    int (*handler)(int) = nullptr;
+    const std::vector<int>* extra = nullptr;
+};
+
+EmplaceQueue<Message> messages;
+
+messages.emplace({ 1, 2, 3 }, "ids");                                                 // Braced initializer
+messages.emplace("header", valueOf(h.totalLength), selectOverload<int(int)>(processVal), nullptr);
+messages.emplace("minimum", valueOf(Widget::MinVals), selectOverload<int(int)>(workOnVal), nullptr);
+messages.emplace("header", h.totalLength, processVal, 0);                             // Error! three failures at once
+
+
+/**
+ * Benchmarks:
+ * Each iteration emplaces 1,024 orders and then drains them, on one thread so the numbers show the construction cost
+ * rather than contention (see Item 24 for registerBenchmark). The temporary case is the old queue: build an Order, then
+ * move it into the slot. Order's symbol and tag are short enough for the small string buffer, so moving them copies
+ * their characters, and every message pays it on top of constructing the temporary and destroying it. The
+ * multi-producer case runs two producers through runConcurrently, each emplacing 512 orders, and drains afterwards.
+ *
+ * Expect a small gap for Order: the compare-exchange and the two string constructions dominate, and the saving per
+ * message is one move plus one destructor. The gap grows with the size of what a move has to copy, e.g. inline
+ * buffers or arrays.
+*/
+struct Order
+{
+    Order(std::string_view symbol, double price, std::uint32_t quantity, std::string_view tag)
+        : symbol(symbol), tag(tag), price(price), quantity(quantity) { }
+
+    std::string symbol;
+    std::string tag;
+    double price;
+    std::uint32_t quantity;
+};
+
+constexpr std::size_t ordersPerBatch = 1024;
+
+inline const bool item30QueueRegistered = []
+{
+    static EmplaceQueue<Order> orders(ordersPerBatch);
+
+    auto sumQuantities = []
+    {
+        std::uint64_t sum = 0;
+        orders.drain([&sum](Order&& order) { sum += order.quantity; });
+
+        return sum;
+    };
+
+    registerBenchmark("Item 30/queue, temporary and move", [sumQuantities]
+    {
+        for (std::uint32_t i = 0; i < ordersPerBatch; ++i)
+        {
+            orders.emplace(Order("ACME", 101.25, i, "desk-7"));
+        }
+
+        return sumQuantities();
+    }, batchBenchmark);
+
+    registerBenchmark("Item 30/queue, emplace", [sumQuantities]
+    {
+        for (std::uint32_t i = 0; i < ordersPerBatch; ++i)
+        {
+            orders.emplace("ACME", 101.25, i, "desk-7");
+        }
+
+        return sumQuantities();
+    }, batchBenchmark);
+
+    registerBenchmark("Item 30/queue, emplace from 2 producers", [sumQuantities]
+    {
+        runConcurrently(2, ordersPerBatch / 2, [](unsigned, std::size_t i)
+                        {
+                            orders.emplace("ACME", 101.25, static_cast<std::uint32_t>(i), "desk-7");
+                        });
+
+        return sumQuantities();
+    }, batchBenchmark);
+
+    return true;
+}();
+
 /**
  * Despite these limitations, perfect forwarding is often effective and simplifies code in many scenarios. However, when
  * it does fail, it's crucial to understand these failure cases and know how to work around them. Each failure case has
@@ -1,4 +1,12 @@
+#include <concepts>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 /**
  * Avoid default capture modes.
@@ -76,4 +84,202 @@ void Widget::addFilter() const
  *
  * In summary, the text cautions against the pitfalls of default capture modes in C++ lambdas and advocates for explicit
  * capture lists to improve code safety and clarity.
-*/
\ No newline at end of file
+*/
+
+
+/**
+ * Storing Filters Without std::function:
+ * Every filter above captures one int, yet FilterContainer stores each one in a std::function: a copyable, type-erased
+ * wrapper that heap-allocates whenever a closure exceeds its (unspecified) small buffer, and whose every call is an
+ * indirect call through that erasure.
+ *
+ * InplaceFunction<bool(int), Capacity> keeps the closure in a fixed buffer inside the wrapper, so it never allocates; a
+ * closure that doesn't fit is a compile-time error rather than a silent heap allocation. It's move-only, which also
+ * means it can hold move-only closures such as those with init captures of std::unique_ptr (see Item 32).
+*/
+template<typename Signature, std::size_t Capacity = 2 * sizeof(void*)>
+class InplaceFunction;
+
+template<typename R, typename... Args, std::size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>
+{
+    public:
+        InplaceFunction() noexcept = default;
+
+        template<typename F>
+            requires (!std::same_as<std::remove_cvref_t<F>, InplaceFunction>
+                      && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        InplaceFunction(F&& f)
+        {
+            using Callable = std::decay_t<F>;
+
+            static_assert(sizeof(Callable) <= Capacity, "Closure too large for InplaceFunction; raise Capacity");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "Closure over-aligned for InplaceFunction");
+            static_assert(std::is_nothrow_move_constructible_v<Callable>, "InplaceFunction moves must not throw");
+
+            ::new (static_cast<void*>(storage)) Callable(std::forward<F>(f));
+
+            invoker = [](void* callable, Args&&... args) -> R
+            {
+                return std::invoke(*static_cast<Callable*>(callable), std::forward<Args>(args)...);
+            };
+
+            // Move-construct into dst (if any), then destroy src
+            relocator = [](void* dst, void* src) noexcept
+            {
+                auto from = static_cast<Callable*>(src);
+
+                if (dst)
+                {
+                    ::new (dst) Callable(std::move(*from));
+                }
+
+                from->~Callable();
+            };
+        }
+
+        InplaceFunction(InplaceFunction&& rhs) noexcept
+        {
+            moveFrom(rhs);
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                reset();
+                moveFrom(rhs);
+            }
+
+            return *this;
+        }
+
+        InplaceFunction(const InplaceFunction&) = delete;
+        InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+        ~InplaceFunction()
+        {
+            reset();
+        }
+
+        // Like std::function, callable through a const wrapper
+        R operator()(Args... args) const
+        {
+            return invoker(storage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return invoker != nullptr;
+        }
+
+    private:
+        void moveFrom(InplaceFunction& rhs) noexcept
+        {
+            if (rhs.relocator)
+            {
+                rhs.relocator(storage, rhs.storage);
+                invoker = std::exchange(rhs.invoker, nullptr);
+                relocator = std::exchange(rhs.relocator, nullptr);
+            }
+        }
+
+        void reset() noexcept
+        {
+            if (relocator)
+            {
+                relocator(nullptr, storage);
+                invoker = nullptr;
+                relocator = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) mutable std::byte storage[Capacity];
+        R (*invoker)(void*, Args&&...) { nullptr };
+        void (*relocator)(void*, void*) noexcept { nullptr };
+};
+
+using InplaceFilterContainer = std::vector<InplaceFunction<bool(int)>>;
+
+InplaceFilterContainer inplaceFilters;
+
+// Same explicit by-value capture as above; the closure is one int, stored inside the InplaceFunction
+inplaceFilters.emplace_back( [divisor](int value) { return value % divisor == 0; } );
+
+
+/**
+ * Filtering in Batches:
+ * Calling every filter on one value before moving to the next jumps between call targets on each call. applyFilters
+ * turns the loops around: each filter runs over all surviving values before the next filter starts, so one indirect
+ * call target stays hot in the branch predictor, and values rejected early are never seen by later filters. It works
+ * for either container.
+*/
+template<typename Filters>
+std::vector<int> applyFilters(const Filters& filters, std::span<const int> values)
+{
+    std::vector<int> passed(values.begin(), values.end());
+
+    for (const auto& filter : filters)
+    {
+        std::erase_if(passed, [&filter](int value) { return !filter(value); });
+    }
+
+    return passed;
+}
+
+
+/**
+ * Benchmarks:
+ * Four divisor filters run over a million values through applyFilters, once with FilterContainer and once with
+ * InplaceFilterContainer (see Item 24 for registerBenchmark). Both closures fit std::function's small buffer in common
+ * implementations, so this measures call overhead. The construction cases add a closure capturing six ints, which
+ * typically exceeds that buffer, so std::function allocates and InplaceFunction (with a larger Capacity) doesn't.
+*/
+constexpr std::size_t filteredValueCount = 1'000'000;
+
+template<typename Filters>
+Filters makeDivisorFilters()
+{
+    Filters filters;
+
+    for (int divisor : { 2, 3, 5, 7 })
+    {
+        filters.emplace_back( [divisor](int value) { return value % divisor != 0; } );
+    }
+
+    return filters;
+}
+
+inline const bool item31Registered = []
+{
+    static std::vector<int> values(filteredValueCount);
+    std::iota(values.begin(), values.end(), 0);
+
+    static auto functionFilters = makeDivisorFilters<FilterContainer>();
+    static auto inplaceFilters = makeDivisorFilters<InplaceFilterContainer>();
+
+    registerBenchmark("Item 31/applyFilters, std::function",
+                      [] { return applyFilters(functionFilters, values).size(); }, batchBenchmark);
+    registerBenchmark("Item 31/applyFilters, InplaceFunction",
+                      [] { return applyFilters(inplaceFilters, values).size(); }, batchBenchmark);
+
+    // Six ints: 24 bytes of captures
+    auto makeWideFilter = []
+    {
+        int a = 2, b = 3, c = 5, d = 7, e = 11, f = 13;
+
+        return [a, b, c, d, e, f](int value) { return value % (a * b * c) == 0 && value % (d * e * f) != 0; };
+    };
+
+    registerBenchmark("Item 31/construct 6-int closure, std::function", [makeWideFilter]
+    {
+        return std::function<bool(int)>(makeWideFilter());
+    });
+
+    registerBenchmark("Item 31/construct 6-int closure, InplaceFunction", [makeWideFilter]
+    {
+        return InplaceFunction<bool(int), 6 * sizeof(int)>(makeWideFilter());
+    });
+
+    return true;
+}();
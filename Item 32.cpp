@@ -1,4 +1,12 @@
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 /**
  * Use init capture to move objects into closures.
  *
@@ -72,4 +80,191 @@ auto func = IsValAndArch(std::make_unique<Widget>());
  *
  * The lifetime of the bind object aligns with the closure, ensuring the moved object remains valid while the closure
  * exists.
-*/
\ No newline at end of file
+*/
+
+
+/**
+ * Queueing Move-Only Closures:
+ * A closure that move-captures a std::unique_ptr is move-only, and std::function requires copyable callables, so it
+ * can't be stored in one. The usual workaround moves the std::unique_ptr into a std::shared_ptr and captures that,
+ * paying for the control block and, since the closure is no longer trivially copyable, a heap-allocated std::function
+ * on top.
+ *
+ * InplaceFunction from Item 31 already stores move-only closures in a buffer of its own, so WorkerQueue holds its tasks
+ * directly. It's a fixed ring of task slots, filled by any number of producers and emptied by a single worker thread:
+ *
+ * - push moves the closure into the next free slot, blocking while the ring is full. Slots are allocated once, so with
+ *   InplaceFunction a push never allocates.
+ *
+ * - The worker moves every ready task, up to batchSize, out of the ring under one lock and runs them without it, so
+ *   producers aren't blocked by running tasks and the lock is taken once per batch rather than once per task.
+ *
+ * - wait blocks until every task pushed so far has run. The destructor runs whatever is still queued and joins the
+ *   worker, which is declared last (see Item 37).
+ *
+ * Task can be any default-constructible, move-assignable callable wrapper, which is how the benchmark below runs the
+ * std::function workaround through the same queue. std::move_only_function (C++23) would work too, but it may
+ * allocate for closures beyond its small buffer.
+*/
+template<typename Task = InplaceFunction<void(), 64>>
+class WorkerQueue
+{
+    public:
+        static constexpr std::size_t batchSize = 32;
+
+        explicit WorkerQueue(std::size_t capacity = 1024)          // Rounded up to a power of two
+            : slots(std::bit_ceil(capacity)), mask(slots.size() - 1), worker([this] { workerLoop(); }) { }
+
+        ~WorkerQueue()
+        {
+            {
+                std::lock_guard<std::mutex> g(m);
+                stopping = true;
+            }
+
+            notEmpty.notify_one();
+            worker.join();
+        }
+
+        WorkerQueue(const WorkerQueue&) = delete;
+        WorkerQueue& operator=(const WorkerQueue&) = delete;
+
+        template<typename F>
+        void push(F&& f)
+        {
+            bool wasEmpty;
+
+            {
+                std::unique_lock<std::mutex> lk(m);
+                notFull.wait(lk, [this] { return tail - head < slots.size(); });
+
+                wasEmpty = head == tail;
+                slots[tail++ & mask] = std::forward<F>(f);
+            }
+
+            if (wasEmpty)
+            {
+                notEmpty.notify_one();                          // The worker only sleeps on an empty ring
+            }
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lk(m);
+            idle.wait(lk, [this] { return completed == tail; });
+        }
+
+    private:
+        void workerLoop()
+        {
+            Task batch[batchSize];
+
+            for (;;)
+            {
+                std::size_t count = 0;
+                bool wasFull;
+
+                {
+                    std::unique_lock<std::mutex> lk(m);
+                    notEmpty.wait(lk, [this] { return head != tail || stopping; });
+
+                    if (head == tail)
+                    {
+                        return;                                 // Stopping, and nothing left to run
+                    }
+
+                    wasFull = tail - head == slots.size();
+
+                    while (head != tail && count < batchSize)
+                    {
+                        batch[count++] = std::move(slots[head++ & mask]);
+                    }
+                }
+
+                if (wasFull)
+                {
+                    notFull.notify_all();
+                }
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    batch[i]();
+                    batch[i] = Task();                          // Destroy the closure, and what it captured, now
+                }
+
+                {
+                    std::lock_guard<std::mutex> g(m);
+                    completed += count;
+
+                    if (completed != tail)
+                    {
+                        continue;
+                    }
+                }
+
+                idle.notify_all();
+            }
+        }
+
+        std::mutex m;
+        std::condition_variable notEmpty, notFull, idle;
+        std::vector<Task> slots;
+        std::size_t mask;
+        std::size_t head = 0, tail = 0, completed = 0;          // Running counts; slot index is count & mask
+        bool stopping = false;
+        std::thread worker;                                     // Last: it starts using the members above at once
+};
+
+WorkerQueue<> queue;
+
+auto pw = std::make_unique<Widget>();
+
+queue.push([pw = std::move(pw)] { pw->isValidated(); });     // Move-only closure, stored in its slot
+queue.push([f = IsValAndArch(std::make_unique<Widget>())] { f(); });   // So is the C++11 functor; its result is dropped
+queue.wait();
+
+
+/**
+ * Benchmarks:
+ * Each iteration pushes 1,024 tasks that each own a std::unique_ptr<int>, then waits for the worker to run them all
+ * (see Item 24 for registerBenchmark), so the time per iteration is the inverse of the queue's throughput. Both cases
+ * allocate the int; the workaround adds a shared_ptr control block and a std::function heap block per task, plus the
+ * atomic reference counting on the way through.
+*/
+constexpr std::size_t tasksPerIteration = 1024;
+
+inline const bool item32Registered = []
+{
+    registerBenchmark("Item 32/WorkerQueue, InplaceFunction", []
+    {
+        static WorkerQueue<> queue;
+        static unsigned long sum = 0;                           // Written only by the worker; read after wait
+
+        for (std::size_t i = 0; i < tasksPerIteration; ++i)
+        {
+            queue.push([p = std::make_unique<unsigned long>(i)] { sum += *p; });
+        }
+
+        queue.wait();
+
+        return sum;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 32/WorkerQueue, std::function + shared_ptr", []
+    {
+        static WorkerQueue<std::function<void()>> queue;
+        static unsigned long sum = 0;
+
+        for (std::size_t i = 0; i < tasksPerIteration; ++i)
+        {
+            auto sp = std::make_shared<std::unique_ptr<unsigned long>>(std::make_unique<unsigned long>(i));
+            queue.push([sp] { sum += **sp; });
+        }
+
+        queue.wait();
+
+        return sum;
+    }, batchBenchmark);
+
+    return true;
+}();
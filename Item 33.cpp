@@ -1,3 +1,10 @@
+#include <cctype>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 /**
  * Use decltype on auto&& parameters to std::forward them.
 */
@@ -93,3 +100,185 @@ auto f = [](auto&&... params)
 };
 
 
+/**
+ * Chaining Stages:
+ * Our code chains many normalize-then-func stages. Writing each chain as a lambda like the one above repeats the
+ * forwarding boilerplate; storing stages in std::function adds an indirect call and a type-erasure boundary per stage.
+ * Pipeline keeps the stages in a tuple and calls them in a compile-time recursion, so the whole chain is one inlinable
+ * call the optimizer sees through:
+ *
+ * - pipeline | normalize | func builds a Pipeline; each | returns a new Pipeline type with one more stage.
+ *
+ * - Each stage is called directly on the previous stage's call, and results pass through decltype(auto), so an rvalue
+ *   stays an rvalue through every stage, and a stage returning by value initializes the next stage's by-value
+ *   parameter in place, as in a hand-written chain. Routing results through another function's forwarding parameters
+ *   (or std::invoke's) would bind each one to a reference first and cost a move per stage. The pipeline's own
+ *   arguments are such parameters, so a first stage taking a prvalue by value costs the one move a hand-written chain
+ *   doesn't.
+ *
+ * - The final result is returned as-is, except that an rvalue reference is turned into a value: it could refer to a
+ *   temporary produced by an earlier stage, which is destroyed before the pipeline returns.
+*/
+template<typename... Stages>
+class Pipeline
+{
+    public:
+        constexpr Pipeline() = default;
+
+        constexpr explicit Pipeline(std::tuple<Stages...> stages)
+            : stages(std::move(stages)) { }
+
+        template<typename... Ts>
+            requires (sizeof...(Stages) > 0)
+        constexpr decltype(auto) operator()(Ts&&... params) const
+        {
+            using Result = decltype(call<sizeof...(Stages) - 1>(std::forward<Ts>(params)...));
+
+            if constexpr (std::is_rvalue_reference_v<Result>)
+            {
+                return std::remove_cvref_t<Result>(call<sizeof...(Stages) - 1>(std::forward<Ts>(params)...));
+            }
+            else
+            {
+                return call<sizeof...(Stages) - 1>(std::forward<Ts>(params)...);
+            }
+        }
+
+        // Append a stage; functions decay to function pointers, closures are copied or moved in
+        template<typename Next>
+        friend constexpr auto operator|(Pipeline lhs, Next&& next)
+        {
+            using Stage = std::decay_t<Next>;
+
+            return Pipeline<Stages..., Stage>(std::tuple_cat(std::move(lhs.stages),
+                                                             std::tuple<Stage>(std::forward<Next>(next))));
+        }
+
+    private:
+        // Stage I applied to the result of the stages before it. Only member pointers go through std::invoke, which
+        // can't be called any other way
+        template<std::size_t I, typename... Ts>
+        constexpr decltype(auto) call(Ts&&... params) const
+        {
+            const auto& stage = std::get<I>(stages);
+
+            if constexpr (I == 0)
+            {
+                return std::invoke(stage, std::forward<Ts>(params)...);
+            }
+            else if constexpr (std::is_member_pointer_v<std::tuple_element_t<I, std::tuple<Stages...>>>)
+            {
+                return std::invoke(stage, call<I - 1>(std::forward<Ts>(params)...));
+            }
+            else
+            {
+                return stage(call<I - 1>(std::forward<Ts>(params)...));
+            }
+        }
+
+        std::tuple<Stages...> stages;
+};
+
+inline constexpr Pipeline<> pipeline;             // Not "pipe", which POSIX already declares
+
+auto f = pipeline | normalize | func;               // Same as the variadic lambda above
+
+static_assert((pipeline | [](int x) { return x + 1; } | [](int x) { return x * 2; })(3) == 8);  // Folds at compile time
+
+
+/**
+ * Checking for Copies:
+ * A stage that takes its argument by rvalue reference and returns it by value costs one move, whether the chain is
+ * written by hand or composed. So does a stage that takes its argument by value, whose parameter is initialized in
+ * place from the previous stage's result; only the first stage costs one more move in a pipeline, whose own
+ * forwarding parameter binds the argument to a reference. checkPipelinePatterns holds both kinds to those counts with
+ * Item 25's expectCounts on Item 42's TrackedString.
+*/
+inline void checkPipelinePatterns()
+{
+    auto stage = [](TrackedString&& s) { return std::move(s); };
+    auto byValue = [](TrackedString s) { return s; };
+
+    expectCounts("hand-written chain", { 0, 2 }, [&] { auto s = stage(stage(TrackedString("name"))); });
+    expectCounts("pipeline", { 0, 2 }, [&] { auto s = (pipeline | stage | stage)(TrackedString("name")); });
+    expectCounts("hand-written chain, by value", { 0, 2 }, [&] { auto s = byValue(byValue(TrackedString("name"))); });
+    expectCounts("pipeline, by value", { 0, 3 }, [&]
+    {
+        auto s = (pipeline | byValue | byValue)(TrackedString("name"));
+    });
+}
+
+checkPipelinePatterns();
+
+
+/**
+ * Benchmarks:
+ * Three stages over a std::string rvalue: lowercase it in place, trim the surrounding spaces, then hash it. The
+ * hand-written lambda and the composed pipeline should time the same. The std::function chain pays an indirect call
+ * per stage and can't be inlined across stages. Here the string work dominates, so expect only a small gap, growing
+ * as the stages get cheaper.
+*/
+std::string lowercase(std::string&& s)
+{
+    for (auto& c : s)
+    {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    return std::move(s);
+}
+
+std::string trim(std::string&& s)
+{
+    const auto first = s.find_first_not_of(' ');
+    const auto last = s.find_last_not_of(' ');
+
+    if (first == std::string::npos)
+    {
+        s.clear();
+    }
+    else
+    {
+        s.erase(last + 1).erase(0, first);
+    }
+
+    return std::move(s);
+}
+
+std::size_t hashName(const std::string& s)
+{
+    return std::hash<std::string> { }(s);
+}
+
+inline const bool item33Registered = []
+{
+    const std::string input = "   Some Mixed-Case Name That Is Past The Small String Limit   ";
+
+    registerBenchmark("Item 33/hand-written lambda", [input]
+    {
+        auto chain = [](auto&&... params)
+        {
+            return hashName(trim(lowercase(std::forward<decltype(params)>(params)...)));
+        };
+
+        return chain(std::string(input));
+    });
+
+    registerBenchmark("Item 33/pipeline", [input]
+    {
+        constexpr auto chain = pipeline | lowercase | trim | hashName;
+
+        return chain(std::string(input));
+    });
+
+    registerBenchmark("Item 33/std::function chain", [input]
+    {
+        static const std::function<std::string(std::string&&)> first = lowercase;
+        static const std::function<std::string(std::string&&)> second = trim;
+        static const std::function<std::size_t(const std::string&)> third = hashName;
+
+        return third(second(first(std::string(input))));
+    });
+
+    return true;
+}();
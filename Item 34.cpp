@@ -1,5 +1,10 @@
 #include <chrono>
+#include <concepts>
+#include <cstddef>
 #include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 /**
  * Prefer lambdas to std::bind.
  *
@@ -141,4 +146,186 @@ auto compressRateL = [w](CompLevel lev)
 
 auto compressRateB = std::bind(compress, std::ref(w), _1);
 
-// is that compressRateB acts as if it holds a reference to w, rather than a copy.
\ No newline at end of file
+// is that compressRateB acts as if it holds a reference to w, rather than a copy.
+
+
+/**
+ * Partial Application Without std::bind:
+ * What std::bind does well is partial application: fix some arguments now, supply the rest later. What makes it costly
+ * is everything else: placeholders that can reorder and drop arguments, nested bind expressions evaluated at call time,
+ * and std::reference_wrapper unwrapping. All of that is type-level machinery the optimizer has to see through, and
+ * calls through a function pointer bound this way are often not inlined.
+ *
+ * bindFront does only the partial application. It decay-copies the callable and the leading arguments into one flat
+ * std::tuple (so, like std::bind, it stores by value, and std::ref still requests a reference), and its call operator
+ * is std::apply into std::invoke, which a compiler inlines completely. Called as an rvalue, it moves the bound
+ * arguments out, as std::bind_front (C++20) does.
+*/
+template<typename F, typename... Bound>
+class FrontBinder
+{
+    public:
+        // Constrained like std::bind_front's, so copying a non-const FrontBinder picks the copy constructor
+        template<typename Fn, typename... Bs>
+            requires (sizeof...(Bs) > 0 || !std::same_as<std::remove_cvref_t<Fn>, FrontBinder>)
+        constexpr explicit FrontBinder(Fn&& f, Bs&&... bs)
+            : func(std::forward<Fn>(f)), bound(std::forward<Bs>(bs)...) { }
+
+        template<typename... Args>
+        constexpr decltype(auto) operator()(Args&&... args) &
+        {
+            return call(func, bound, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        constexpr decltype(auto) operator()(Args&&... args) const&
+        {
+            return call(func, bound, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        constexpr decltype(auto) operator()(Args&&... args) &&
+        {
+            return call(std::move(func), std::move(bound), std::forward<Args>(args)...);
+        }
+
+    private:
+        template<typename Fn, typename Tuple, typename... Args>
+        static constexpr decltype(auto) call(Fn&& f, Tuple&& t, Args&&... args)
+        {
+            return std::apply([&](auto&&... bs) -> decltype(auto)
+                              {
+                                  return std::invoke(std::forward<Fn>(f), std::forward<decltype(bs)>(bs)...,
+                                                     std::forward<Args>(args)...);
+                              },
+                              std::forward<Tuple>(t));
+        }
+
+        [[no_unique_address]] F func;
+        std::tuple<Bound...> bound;
+};
+
+template<typename F, typename... Bs>
+constexpr auto bindFront(F&& f, Bs&&... bs)
+{
+    return FrontBinder<std::decay_t<F>, std::unwrap_ref_decay_t<Bs>...>(std::forward<F>(f), std::forward<Bs>(bs)...);
+}
+
+
+/**
+ * Binding a Function, Not a Function Pointer:
+ * Passed as an argument, a function decays to a pointer, and the binder stores that pointer just as std::bind does;
+ * the call can only be inlined if the compiler propagates the pointer's value. bindFront<func>(...) takes the function
+ * as a template argument instead, so the callee is part of the binder's type, occupies no storage, and the call is a
+ * direct call.
+*/
+template<auto Func>
+struct FunctionConstant
+{
+    template<typename... Args>
+    constexpr decltype(auto) operator()(Args&&... args) const
+    {
+        return std::invoke(Func, std::forward<Args>(args)...);
+    }
+};
+
+template<auto Func, typename... Bs>
+constexpr auto bindFront(Bs&&... bs)
+{
+    return bindFront(FunctionConstant<Func> { }, std::forward<Bs>(bs)...);
+}
+
+
+/**
+ * Re-expressing the Examples:
+ * compressRateB binds the leading argument, so bindFront expresses it directly, and sizeof shows nothing is stored
+ * beyond the Widget.
+ *
+ * setSoundB is a different story. Its first argument, the alarm time, has to be computed when the alarm is set, not
+ * when the binder is made; that's what the nested std::bind above is for. A binder stores values, so what bindFront can
+ * express is an alarm at a time known up front, with the sound and duration supplied per call. For "one hour from now"
+ * the lambda remains the clearest tool. Overloaded setAlarm still needs the cast, as with std::bind.
+*/
+auto compressRateF = bindFront<compress>(w);                    // w copied into the binder, as with std::bind
+auto compressRateFRef = bindFront<compress>(std::ref(w));       // Acts as if it holds a reference to w
+
+static_assert(sizeof(compressRateF) == sizeof(Widget));        // No function pointer stored
+
+compressRateF(CompLevel::High);
+
+auto noon = /* ... */;
+
+auto setSoundAtNoonF = bindFront<static_cast<SetAlarm3ParamType>(setAlarm)>(noon);
+
+setSoundAtNoonF(Sound::Siren, 30s);
+
+
+/**
+ * Benchmarks:
+ * Each case makes one call through a bind object, a lambda, or a bindFront binder (see Item 24 for registerBenchmark).
+ * The callees are visible stand-ins, so the difference between the cases is only what the compiler can see through.
+ * Lambdas and bindFront should be indistinguishable from a direct call; std::bind objects, which hold the callee as a
+ * function pointer behind placeholder machinery, often are not.
+*/
+struct Compressible
+{
+    int size;
+};
+
+Compressible compressStandIn(const Compressible& w, CompLevel lev)
+{
+    return { w.size >> static_cast<int>(lev) };
+}
+
+inline Time lastAlarm;
+
+void setAlarmStandIn(Time t, Sound s, Duration d)
+{
+    lastAlarm = t + d * (static_cast<int>(s) + 1);
+}
+
+inline const bool item34Registered = []
+{
+    static Compressible cw { 1 << 20 };
+
+    static auto compressBind = std::bind(compressStandIn, cw, _1);
+    static auto compressLambda = [cw = cw](CompLevel lev) { return compressStandIn(cw, lev); };
+    static auto compressFront = bindFront<compressStandIn>(cw);
+
+    registerBenchmark("Item 34/compress, std::bind", [] { return compressBind(CompLevel::Normal).size; });
+    registerBenchmark("Item 34/compress, lambda", [] { return compressLambda(CompLevel::Normal).size; });
+    registerBenchmark("Item 34/compress, bindFront", [] { return compressFront(CompLevel::Normal).size; });
+
+    // A fixed alarm time, so every case measures the call and nothing else. A front binder can't bind the trailing
+    // duration, so all three bind the time only and get the sound and duration per call
+    static const Time noon = steady_clock::now() + 1h;
+
+    static auto alarmBind = std::bind(setAlarmStandIn, noon, _1, _2);
+    static auto alarmLambda = [](Sound s, Duration d) { setAlarmStandIn(noon, s, d); };
+    static auto alarmFront = bindFront<setAlarmStandIn>(noon);
+
+    auto lastAlarmTicks = [] { return lastAlarm.time_since_epoch().count(); };
+
+    registerBenchmark("Item 34/setAlarm, std::bind", [lastAlarmTicks]
+    {
+        alarmBind(Sound::Beep, 30s);
+
+        return lastAlarmTicks();
+    });
+
+    registerBenchmark("Item 34/setAlarm, lambda", [lastAlarmTicks]
+    {
+        alarmLambda(Sound::Beep, 30s);
+
+        return lastAlarmTicks();
+    });
+
+    registerBenchmark("Item 34/setAlarm, bindFront", [lastAlarmTicks]
+    {
+        alarmFront(Sound::Beep, 30s);
+
+        return lastAlarmTicks();
+    });
+
+    return true;
+}();
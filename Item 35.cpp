@@ -0,0 +1,299 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+/**
+ * Prefer task-based programming to thread-based.
+ *
+ *
+ * The std::thread API offers no direct way to get return values from asynchronously run functions, and if those
+ * functions throw, the program is terminated.
+ *
+ * Thread-based programming calls for manual management of thread exhaustion, oversubscription, load balancing, and
+ * adaptation to new platforms.
+ *
+ * Task-based programming via std::async with the default launch policy handles most of these issues for you.
+*/
+
+int doAsyncWork();
+
+/**
+ * Thread-Based vs. Task-Based:
+ * To run doAsyncWork asynchronously, a std::thread can be created to run it (thread-based), or doAsyncWork can be passed
+ * to std::async (task-based). In the task-based version, the function object passed to std::async is considered a task.
+*/
+std::thread t(doAsyncWork);                 // Thread-based
+
+auto fut = std::async(doAsyncWork);         // Task-based; "fut" for "future"
+
+
+/**
+ * Return Values and Exceptions:
+ * The future returned from std::async offers get, which hands back doAsyncWork's return value. If doAsyncWork throws,
+ * get rethrows the exception. With the thread-based approach there is no direct way to get the result, and an exception
+ * escaping doAsyncWork calls std::terminate.
+*/
+
+/**
+ * Three Meanings of "Thread":
+ * - Hardware threads are the threads that actually perform computation.
+ *
+ * - Software threads (OS or system threads) are the threads the operating system manages across all processes and
+ *   schedules for execution on hardware threads.
+ *
+ * - std::threads are C++ objects that act as handles to underlying software threads.
+*/
+
+/**
+ * Thread Exhaustion and Oversubscription:
+ * Software threads are a limited resource. Creating more than the system can provide throws std::system_error, even if
+ * doAsyncWork is noexcept. Even below that limit, more ready-to-run software threads than hardware threads means
+ * oversubscription: frequent context switches, cold caches and threads migrating between cores.
+ *
+ * Avoiding these problems by hand is hard, because the optimal ratio of software to hardware threads depends on how
+ * often the software threads become runnable, and that changes over time and across machines.
+*/
+int doAsyncWork() noexcept;                 // See Item 14 for noexcept
+
+std::thread t(doAsyncWork);                 // Throws if no more threads are available
+
+
+/**
+ * Letting the Library Decide:
+ * std::async shifts the thread-management problem to the Standard Library implementer. With the default launch policy
+ * it may run the task on the thread that calls get or wait, so it never throws for lack of threads. Item 36 covers what
+ * that flexibility costs.
+*/
+
+/**
+ * When Threads Are Still Appropriate:
+ * - Access to the API of the underlying threading implementation (priorities, affinities) through native_handle.
+ *
+ * - The need to optimize thread usage for a known execution profile, e.g. a server with a fixed hardware profile.
+ *
+ * - Threading technology beyond the C++ concurrency API, such as thread pools where the C++ implementation offers none.
+*/
+
+
+/**
+ * A Task-Based Execution Engine:
+ * The last bullet is the case for our own code, so the engine below puts a task-based API on top of a fixed set of
+ * std::threads. One worker per hardware thread avoids oversubscription, and each worker owns a deque of tasks:
+ *
+ * - Tasks submitted from a worker go to the back of that worker's own deque and are popped from the back (LIFO), so the
+ *   most recently spawned (and most likely cache-warm) work runs next.
+ *
+ * - An idle worker steals from the front (FIFO) of another worker's deque, taking the oldest and usually largest piece
+ *   of outstanding work. This is what load-balances the pool.
+ *
+ * Each deque is guarded by its own mutex, so the owner and the thieves only contend on the same deque and never on a
+ * pool-wide lock. Idle workers block on a condition variable instead of spinning (see Item 39).
+ *
+ * ---------------------------------------------------------------------------------------------------------------------
+ *
+ * Results and Exceptions:
+ * submit wraps the call in a std::packaged_task, so callers get a std::future just as with std::async, and exceptions
+ * reach get instead of terminating the program. std::function requires a copyable target, so the move-only
+ * packaged_task is held through a std::shared_ptr.
+*/
+using Task = std::function<void()>;
+
+class WorkStealingDeque
+{
+    public:
+        // Owner end
+        void pushBack(Task task)
+        {
+            std::lock_guard<std::mutex> g { m };
+            tasks.push_back(std::move(task));
+        }
+
+        std::optional<Task> popBack()
+        {
+            std::lock_guard<std::mutex> g { m };
+
+            if (tasks.empty())
+            {
+                return std::nullopt;
+            }
+
+            auto task = std::move(tasks.back());
+            tasks.pop_back();
+
+            return task;
+        }
+
+        // Thief end
+        std::optional<Task> stealFront()
+        {
+            std::lock_guard<std::mutex> g { m };
+
+            if (tasks.empty())
+            {
+                return std::nullopt;
+            }
+
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+
+            return task;
+        }
+
+    private:
+        std::mutex m;
+        std::deque<Task> tasks;
+};
+
+
+class ThreadPool
+{
+    public:
+        explicit ThreadPool(unsigned threadCount = std::max(1u, std::thread::hardware_concurrency()))
+        {
+            queues.reserve(threadCount);
+
+            for (unsigned i = 0; i < threadCount; ++i)
+            {
+                queues.push_back(std::make_unique<WorkStealingDeque>());
+            }
+
+            // Start threads only after every queue exists; workers steal from all of them
+            workers.reserve(threadCount);
+
+            for (unsigned i = 0; i < threadCount; ++i)
+            {
+                workers.emplace_back([this, i] { workerLoop(i); });
+            }
+        }
+
+        // Drain outstanding tasks, then join: the threads are unjoinable on every path (see Item 37)
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> g { sleepMutex };
+                done = true;
+            }
+
+            wakeUp.notify_all();
+
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        template<typename F, typename... Ts>
+        auto submit(F&& f, Ts&&... params)
+        {
+            using ResultType = std::invoke_result_t<std::decay_t<F>, std::decay_t<Ts>...>;
+
+            // Arguments are decay-copied, as std::async and std::thread do
+            auto task = std::make_shared<std::packaged_task<ResultType()>>(
+                [f = std::forward<F>(f), ... params = std::forward<Ts>(params)]() mutable
+                {
+                    return std::invoke(std::move(f), std::move(params)...);
+                });
+
+            auto fut = task->get_future();
+
+            {
+                // Counting under the lock means a worker can't check pending and then miss the notification
+                std::lock_guard<std::mutex> g { sleepMutex };
+                ++pending;
+            }
+
+            // Workers spawning subtasks keep them local; everyone else spreads tasks round-robin
+            auto index = (currentPool == this) ? currentWorker
+                                               : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            queues[index]->pushBack([task] { (*task)(); });
+
+            wakeUp.notify_one();
+
+            return fut;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return workers.size();
+        }
+
+    private:
+        std::optional<Task> findTask(std::size_t index)
+        {
+            if (auto task = queues[index]->popBack())
+            {
+                return task;
+            }
+
+            // Start with the neighbor so thieves don't all hit queue 0
+            for (std::size_t offset = 1; offset < queues.size(); ++offset)
+            {
+                if (auto task = queues[(index + offset) % queues.size()]->stealFront())
+                {
+                    return task;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        void workerLoop(std::size_t index)
+        {
+            currentPool = this;
+            currentWorker = index;
+
+            while (true)
+            {
+                if (auto task = findTask(index))
+                {
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    (*task)();
+
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lk { sleepMutex };
+                wakeUp.wait(lk, [this] { return pending.load(std::memory_order_relaxed) > 0 || done; });
+
+                if (done && pending.load(std::memory_order_relaxed) == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        static inline thread_local ThreadPool* currentPool { nullptr };
+        static inline thread_local std::size_t currentWorker { 0 };
+
+        std::vector<std::unique_ptr<WorkStealingDeque>> queues;
+        std::atomic<std::size_t> nextQueue { 0 };
+        std::atomic<std::size_t> pending { 0 };         // Submitted but not yet started
+
+        std::mutex sleepMutex;
+        std::condition_variable wakeUp;
+        bool done { false };                            // Guarded by sleepMutex
+
+        // Declared last so the threads start after everything they use exists (see Item 37)
+        std::vector<std::thread> workers;
+};
+
+
+// Task-based use of the pool looks like task-based use of std::async
+ThreadPool pool;
+
+auto fut = pool.submit(doAsyncWork);
+
+auto result = fut.get();                    // Result or exception from doAsyncWork
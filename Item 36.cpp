@@ -0,0 +1,229 @@
+#include <chrono>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+/**
+ * Specify std::launch::async if asynchronicity is essential.
+ *
+ *
+ * The default launch policy for std::async permits both asynchronous and synchronous task execution.
+ *
+ * This flexibility leads to uncertainty when accessing thread_locals, implies that the task may never execute, and
+ * affects program logic for timeout-based wait calls.
+ *
+ * Specify std::launch::async if asynchronous task execution is essential.
+*/
+
+void f();
+
+/**
+ * Launch Policies:
+ * - std::launch::async means f must be run asynchronously, i.e., on a different thread.
+ *
+ * - std::launch::deferred means f may run only when get or wait is called on the future returned by std::async. When
+ *   that happens, f executes synchronously on the calling thread. If neither is called, f never runs.
+ *
+ * The default policy is the bitwise OR of the two, so the implementation chooses.
+*/
+auto fut1 = std::async(f);                                          // Run f using default launch policy
+
+auto fut2 = std::async(std::launch::async | std::launch::deferred, f);        // Run f either async or deferred
+
+
+/**
+ * Consequences of the Default Policy:
+ * - It's not possible to predict whether f will run concurrently with the calling thread.
+ *
+ * - It's not possible to predict whether f runs on a thread different from the one invoking get or wait, so it's not
+ *   possible to predict which thread_local variables f reads or writes.
+ *
+ * - It may not be possible to predict whether f runs at all.
+*/
+
+/**
+ * Timeout-Based Loops:
+ * wait_for and wait_until on a deferred task return std::future_status::deferred and never std::future_status::ready,
+ * so a loop waiting for ready can run forever. Checking for a deferred task first, with a zero timeout, fixes it.
+*/
+using namespace std::literals;              // For C++14 duration suffixes; see Item 34
+
+void f()
+{
+    std::this_thread::sleep_for(1s);
+}
+
+auto fut = std::async(f);
+
+// Loop until f has finished running... which may never happen!
+while (fut.wait_for(100ms) != std::future_status::ready)
+{
+    /* ... */
+}
+
+// If task is deferred...
+if (fut.wait_for(0s) == std::future_status::deferred)
+{
+    // ...use wait or get on fut to call f synchronously
+}
+else
+{
+    // Task isn't deferred; infinite loop not possible (assuming f finishes)
+    while (fut.wait_for(100ms) != std::future_status::ready)
+    {
+        // task is neither deferred nor ready, so do concurrent work until it's ready
+    }
+
+    // fut is ready
+}
+
+
+/**
+ * Guaranteeing Asynchronous Execution:
+ * When asynchronicity is essential, pass std::launch::async explicitly. reallyAsync does that once, so call sites can't
+ * forget it.
+*/
+// C++14
+template<typename F, typename... Ts>
+inline auto reallyAsync(F&& f, Ts&&... params)
+{
+    return std::async(std::launch::async, std::forward<F>(f), std::forward<Ts>(params)...);
+}
+
+auto fut = reallyAsync(f);                  // Run f asynchronously; throw if std::async would throw
+
+
+/**
+ * An Explicit Launch Policy for the Execution Engine:
+ * Our code can run tasks three ways: on a new std::async thread, deferred on the thread calling get, or on the work-
+ * stealing pool from Item 35. Launch makes that choice visible at the call site instead of leaving it to the default
+ * policy, and launchTask maps it onto the right mechanism while always handing back a std::future.
+ *
+ * ---------------------------------------------------------------------------------------------------------------------
+ *
+ * Blocking Futures:
+ * The futures from Launch::async come from std::async, so the last one referring to a task blocks in its destructor
+ * until the task completes (see Item 38). Pool futures come from std::packaged_task and never block in their
+ * destructors; the pool's own destructor is what waits.
+*/
+enum class Launch { async, deferred, pool };
+
+inline ThreadPool& defaultPool()
+{
+    static ThreadPool pool;                     // One worker per hardware thread (see Item 35)
+
+    return pool;
+}
+
+template<typename F, typename... Ts>
+auto launchTask(Launch policy, F&& f, Ts&&... params)
+        -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Ts>...>>
+{
+    switch (policy)
+    {
+        case Launch::async:
+            return std::async(std::launch::async, std::forward<F>(f), std::forward<Ts>(params)...);
+
+        case Launch::deferred:
+            return std::async(std::launch::deferred, std::forward<F>(f), std::forward<Ts>(params)...);
+
+        case Launch::pool:
+        default:
+            return defaultPool().submit(std::forward<F>(f), std::forward<Ts>(params)...);
+    }
+}
+
+auto fut = launchTask(Launch::pool, f);     // Runs on a pool worker; fut.wait_for never reports deferred
+
+
+/**
+ * Benchmarks:
+ * Each case measures the round trip of one small task: launch, run, and get. The harness from Item 24 reports the median
+ * and p99 of that round trip, so the p99 column is the tail latency. The batch cases launch 1,000 tasks before waiting
+ * for any of them: their per-iteration time is the cost of a whole batch, i.e. the inverse of throughput.
+ *
+ * std::launch::async typically costs a thread creation per task, like thread-per-task, and its tail is dominated by the
+ * scheduler. The pool pays a queue push, a wake-up and a steal, and it is the only one that doesn't oversubscribe in the
+ * batch cases.
+*/
+// Stand-in for a few nanoseconds of real work
+unsigned smallTask(unsigned x) noexcept
+{
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        x = x * 31 + i;
+    }
+
+    return x;
+}
+
+constexpr unsigned batchSize = 1000;
+
+inline const bool item36Registered = []
+{
+    registerBenchmark("Item 36/thread-per-task round trip", []
+    {
+        unsigned result = 0;
+        std::thread t([&result] { result = smallTask(1); });
+        t.join();
+
+        return result;
+    }, batchBenchmark);
+
+    registerBenchmark("Item 36/std::launch::async round trip", []
+    {
+        return launchTask(Launch::async, smallTask, 1).get();
+    }, batchBenchmark);
+
+    registerBenchmark("Item 36/pool round trip", []
+    {
+        return launchTask(Launch::pool, smallTask, 1).get();
+    }, batchBenchmark);
+
+    registerBenchmark("Item 36/thread-per-task batch", []
+    {
+        std::vector<unsigned> results(batchSize);
+        std::vector<std::thread> threads;
+        threads.reserve(batchSize);
+
+        for (unsigned i = 0; i < batchSize; ++i)
+        {
+            threads.emplace_back([&results, i] { results[i] = smallTask(i); });
+        }
+
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+
+        return std::accumulate(results.begin(), results.end(), 0u);
+    }, batchBenchmark);
+
+    // Batch-launch under a given policy, then collect every result
+    auto batch = [](Launch policy)
+    {
+        std::vector<std::future<unsigned>> futs;
+        futs.reserve(batchSize);
+
+        for (unsigned i = 0; i < batchSize; ++i)
+        {
+            futs.push_back(launchTask(policy, smallTask, i));
+        }
+
+        unsigned sum = 0;
+
+        for (auto& fut : futs)
+        {
+            sum += fut.get();
+        }
+
+        return sum;
+    };
+
+    registerBenchmark("Item 36/std::launch::async batch", [batch] { return batch(Launch::async); }, batchBenchmark);
+    registerBenchmark("Item 36/pool batch", [batch] { return batch(Launch::pool); }, batchBenchmark);
+
+    return true;
+}();
@@ -0,0 +1,153 @@
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+/**
+ * Make std::threads unjoinable on all paths.
+ *
+ *
+ * Make std::threads unjoinable on all paths.
+ *
+ * join-on-destruction can lead to difficult-to-debug performance anomalies.
+ *
+ * detach-on-destruction can lead to difficult-to-debug undefined behavior.
+ *
+ * Declare std::thread objects last in lists of data members.
+*/
+
+/**
+ * Joinable and Unjoinable std::threads:
+ * A joinable std::thread corresponds to an underlying asynchronous thread of execution that is or could be running.
+ * Unjoinable std::threads are default-constructed std::threads, std::threads that have been moved from, joined, or
+ * detached.
+ *
+ * If the destructor of a joinable std::thread is invoked, execution of the program is terminated.
+*/
+constexpr auto tenMillion = 10'000'000;                 // C++14 digit separators
+
+bool conditionsAreSatisfied();
+bool filter(int value);
+void performComputation(const std::vector<int>& goodVals);
+
+// Returns whether computation was performed
+bool doWork(std::function<bool(int)> filter, int maxVal = tenMillion)
+{
+    // Values satisfying filter
+    std::vector<int> goodVals;
+
+    // Populate goodVals
+    std::thread t([&filter, maxVal, &goodVals]
+                  {
+                      for (auto i = 0; i <= maxVal; ++i)
+                      {
+                          if (filter(i))
+                          {
+                              goodVals.push_back(i);
+                          }
+                      }
+                  });
+
+    // Use t's native handle to set t's priority
+    auto nh = t.native_handle();
+
+    if (conditionsAreSatisfied())
+    {
+        t.join();                                       // Let t finish
+        performComputation(goodVals);
+
+        return true;                                    // Computation was performed
+    }
+
+    return false;                                       // Computation was not performed; t is joinable, so terminate!
+}
+
+
+/**
+ * Why Not Join or Detach Implicitly:
+ * - An implicit join would make doWork wait for t to finish filtering ten million values even when conditionsAreSatisfied
+ *   already returned false, a performance anomaly that's hard to track down.
+ *
+ * - An implicit detach would leave t running and writing into goodVals after doWork's stack frame is gone.
+ *
+ * The Standard therefore terminates, and it's up to the programmer to make the std::thread unjoinable on every path out
+ * of the scope, including exceptions. The usual tool for "do this on every path" is an RAII class.
+*/
+class ThreadRAII
+{
+    public:
+        enum class DtorAction { join, detach };         // See Item 10 for enum class info
+
+        // In dtor, take action a on t
+        ThreadRAII(std::thread&& t, DtorAction a)
+            : action(a), t(std::move(t)) { }
+
+        ~ThreadRAII()
+        {
+            // See below for joinability test
+            if (t.joinable())
+            {
+                if (action == DtorAction::join)
+                {
+                    t.join();
+                }
+                else
+                {
+                    t.detach();
+                }
+            }
+        }
+
+        // Support moving; see Item 17
+        ThreadRAII(ThreadRAII&&) = default;
+        ThreadRAII& operator=(ThreadRAII&&) = default;
+
+        std::thread& get() { return t; }
+
+    private:
+        DtorAction action;
+        std::thread t;
+};
+
+
+/**
+ * Using ThreadRAII:
+ * Joining is the lesser evil here, so doWork asks ThreadRAII to join on destruction. The performance anomaly remains
+ * possible; avoiding it requires interruptible threads (C++20's std::jthread with a std::stop_token), which the
+ * execution engine in Item 35 sidesteps by joining only at pool shutdown.
+*/
+bool doWork(std::function<bool(int)> filter, int maxVal = tenMillion)
+{
+    std::vector<int> goodVals;
+
+    ThreadRAII t(std::thread([&filter, maxVal, &goodVals]
+                             {
+                                 for (auto i = 0; i <= maxVal; ++i)
+                                 {
+                                     if (filter(i))
+                                     {
+                                         goodVals.push_back(i);
+                                     }
+                                 }
+                             }),
+                 ThreadRAII::DtorAction::join);
+
+    auto nh = t.get().native_handle();
+
+    if (conditionsAreSatisfied())
+    {
+        t.get().join();
+        performComputation(goodVals);
+
+        return true;
+    }
+
+    return false;
+}
+
+
+/**
+ * Data Member Order:
+ * Data members are initialized in declaration order, so a std::thread member that starts running immediately should be
+ * declared last: everything its function touches is then already constructed. ThreadRAII declares t after action, and
+ * Item 35's ThreadPool declares its workers after the queues they steal from.
+*/
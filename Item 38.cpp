@@ -0,0 +1,72 @@
+#include <future>
+#include <vector>
+/**
+ * Be aware of varying thread handle destructor behavior.
+ *
+ *
+ * Future destructors normally just destroy the future’s data members.
+ *
+ * The final future referring to a shared state for a non-deferred task launched via std::async blocks until the task
+ * completes.
+*/
+
+/**
+ * Futures and the Shared State:
+ * The callee's result can't live in the callee's std::promise, which may be destroyed before the caller calls get, and it
+ * can't live in the caller's future, which may be turned into a std::shared_future and copied. It lives in the shared
+ * state, a typically heap-based object that both sides refer to.
+*/
+
+/**
+ * Destructor Behavior:
+ * - The destructor for the last future referring to a shared state for a non-deferred task launched via std::async
+ *   blocks until the task completes. In essence, it does an implicit join on the thread running the task.
+ *
+ * - The destructor for every other future simply destroys the future object. For deferred tasks for which this is the
+ *   final future, the deferred task will never run.
+*/
+// This container might block in its dtor, because one or more contained futures could refer to a shared state for a
+// non-deferred task launched via std::async
+std::vector<std::future<void>> futs;                // See Item 39 for info on std::future<void>
+
+// Widget objects might block in their dtors
+class Widget
+{
+    public:
+        /* ... */
+
+    private:
+        std::shared_future<double> fut;
+};
+
+
+/**
+ * Futures from std::packaged_task:
+ * A shared state can also come from std::packaged_task. Its futures never block in their destructors; whatever runs the
+ * task decides what happens at the end. Here that's a std::thread, so the usual Item 37 rules apply.
+*/
+// Function to run
+int calcValue();
+
+// Wrap calcValue so it can run asynchronously
+std::packaged_task<int()> pt(calcValue);
+
+// Get future for pt
+auto fut = pt.get_future();
+
+// std::packaged_task is move-only
+std::thread t(std::move(pt));
+
+/* ... */                                           // t must be joined or detached on every path out of this scope
+
+
+/**
+ * Consequences for the Execution Engine:
+ * Item 35's ThreadPool hands out packaged_task futures, so dropping one is cheap and never waits. Launch::async in
+ * Item 36 still goes through std::async, so a temporary future from it blocks at the end of the full expression:
+*/
+void doAsyncWork();
+
+launchTask(Launch::async, doAsyncWork);             // Blocks until doAsyncWork finishes; executes synchronously in effect
+
+launchTask(Launch::pool, doAsyncWork);              // Doesn't block; the task still runs on a pool worker
@@ -0,0 +1,125 @@
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+/**
+ * Consider void futures for one-shot event communication.
+ *
+ *
+ * For simple event communication, condvar-based designs require a superfluous mutex, impose constraints on the relative
+ * progress of detecting and reacting tasks, and require reacting tasks to verify that the event has taken place.
+ *
+ * Designs employing a flag avoid those problems, but are based on polling, not blocking.
+ *
+ * A condvar and flag can be used together, but the resulting communications mechanism is somewhat stilted.
+ *
+ * Using std::promises and futures dodges these issues, but the approach uses heap memory for shared states, and it’s
+ * limited to one-shot communication.
+*/
+
+/**
+ * Condition Variables:
+ * The detecting task notifies a condvar, and the reacting task waits on it while holding a mutex. If the detecting task
+ * notifies before the reacting task waits, the reacting task hangs; and spurious wakeups mean the reacting task has to
+ * check that the event really occurred, which it often can't.
+*/
+std::condition_variable cv;                         // Condvar for event
+std::mutex m;                                       // Mutex for use with cv
+
+// Detecting task: detect event, tell reacting task
+cv.notify_one();
+
+// Reacting task: prepare to react, then...
+{
+    std::unique_lock<std::mutex> lk(m);             // Lock mutex
+    cv.wait(lk);                                    // Wait for notify; this isn't correct!
+    /* ... */                                       // React to event (m is locked)
+}                                                   // Close crit. section; unlock m via lk's dtor
+
+
+/**
+ * A Shared Flag:
+ * A std::atomic<bool> avoids the mutex and the lost-notification problem, but the reacting task polls, occupying a
+ * hardware thread while it waits.
+*/
+std::atomic<bool> flag(false);                      // Shared flag; see Item 40 for std::atomic
+
+flag = true;                                        // Detecting task: tell reacting task
+
+while (!flag);                                      // Reacting task: wait for event
+
+
+/**
+ * Condvar Plus Flag:
+ * Combining them works without polling or spurious-wakeup confusion, but the detecting task has to lock a mutex and set
+ * a flag just to send a notification. Item 35's ThreadPool uses exactly this pattern for its idle workers, because there
+ * the event (new work arrived) repeats.
+*/
+bool flag(false);                                   // Not std::atomic; guarded by m
+
+// Detecting task
+{
+    std::lock_guard<std::mutex> g(m);
+    flag = true;
+}
+
+cv.notify_one();
+
+// Reacting task
+{
+    std::unique_lock<std::mutex> lk(m);
+    cv.wait(lk, [] { return flag; });               // Use lambda to avoid spurious wakeups
+    /* ... */
+}
+
+
+/**
+ * void Futures:
+ * For a one-shot event, the detecting task sets a std::promise<void> and the reacting task waits on the corresponding
+ * future. No mutex, no lost notification, no spurious wakeup, no polling. The cost is a heap-allocated shared state, and
+ * a promise can be set only once.
+*/
+std::promise<void> p;                               // Promise for communications channel
+
+p.set_value();                                      // Detecting task: tell reacting task
+
+p.get_future().wait();                              // Reacting task: wait on future corresponding to p
+
+
+/**
+ * Suspending a Thread Before It Runs:
+ * A void future lets a thread be created, configured through its native handle, and only then released. Sharing the
+ * future lets several reacting threads wait on the same event.
+*/
+void react();                                       // Func for reacting task
+
+void detect()
+{
+    std::promise<void> p;
+
+    auto sf = p.get_future().share();               // sf's type is std::shared_future<void>
+
+    // Container for reacting threads
+    std::vector<std::thread> vt;
+    constexpr auto threadsToRun = 8;
+
+    for (int i = 0; i < threadsToRun; ++i)
+    {
+        // Wait on local copy of sf; see Item 42 for info on emplace_back
+        vt.emplace_back([sf] { sf.wait(); react(); });
+    }
+
+    /* ... */                                       // detect hangs if this "..." code throws; see Item 37 for ThreadRAII
+
+    p.set_value();                                  // Unsuspend all threads
+
+    /* ... */
+
+    // Make all threads unjoinable; see Item 2 for info on "auto&"
+    for (auto& t : vt)
+    {
+        t.join();
+    }
+}
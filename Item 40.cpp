@@ -0,0 +1,85 @@
+#include <atomic>
+#include <iostream>
+/**
+ * Use std::atomic for concurrency, volatile for special memory.
+ *
+ *
+ * std::atomic is for data accessed from multiple threads without using mutexes. It’s a tool for writing concurrent
+ * software.
+ *
+ * volatile is for memory where reads and writes should not be optimized away. It’s a tool for working with special
+ * memory.
+*/
+
+/**
+ * std::atomic:
+ * Operations on std::atomic objects behave as if they were inside a mutex-protected critical section, but are usually
+ * implemented with special machine instructions. Read-modify-write operations such as ++ are atomic as a whole.
+ *
+ * volatile offers no such guarantee: two threads incrementing a volatile counter is a data race and undefined behavior.
+*/
+std::atomic<int> ai(0);                             // Initialize ai to 0
+ai = 10;                                            // Atomically set ai to 10
+std::cout << ai;                                    // Atomically read ai's value; the call to operator<< isn't atomic
+++ai;                                               // Atomically increment ai to 11
+--ai;                                               // Atomically decrement ai to 10
+
+volatile int vi(0);                                 // Initialize vi to 0
+vi = 10;                                            // Set vi to 10
+std::cout << vi;                                    // Read vi's value
+++vi;                                               // Increment vi to 11
+--vi;                                               // Decrement vi to 10
+
+// Thread 1                                         // Thread 2
+++ai;                                               --ai;         // Well defined: ai ends up 0
+++vi;                                               --vi;         // Data race: vi could be anything
+
+
+/**
+ * Ordering:
+ * Sequentially consistent std::atomic stores also restrict reordering: no code preceding a store of valAvailable may
+ * appear to another thread to come after it. A volatile store imposes no such constraint on surrounding code, so it
+ * can't be used to publish imptValue to another thread.
+*/
+std::atomic<bool> valAvailable(false);
+
+auto imptValue = computeImportantValue();           // Compute value
+valAvailable = true;                                // Tell other task it's available
+
+
+/**
+ * Special Memory:
+ * volatile tells compilers that a location doesn't behave like normal memory, e.g. memory-mapped I/O, so redundant loads
+ * and dead stores must be kept. std::atomic operations may be merged or eliminated by the optimizer, which is why the
+ * two can be combined for memory-mapped locations shared between threads.
+*/
+volatile int x;
+
+auto y = x;                                         // Read x
+y = x;                                              // Read x again (can't be optimized away)
+
+x = 10;                                             // Write x (can't be optimized away)
+x = 20;                                             // Write x again
+
+volatile std::atomic<int> vai;                      // Operations on vai are atomic and can't be optimized away
+
+
+/**
+ * Copying std::atomic:
+ * std::atomic's copy operations are deleted, because copy-constructing from one atomic into another would need a single
+ * atomic instruction reading one location and writing another, which hardware generally lacks. load and store express
+ * the two separate atomic operations explicitly.
+*/
+std::atomic<int> x;
+
+auto y = x;                                         // Error!
+std::atomic<int> y(x.load());                       // Read x
+y.store(x.load());                                  // Read x again
+
+
+/**
+ * Memory Order in the Execution Engine:
+ * Item 35's ThreadPool uses std::memory_order_relaxed for its round-robin index and its pending counter. Neither
+ * publishes data: the tasks themselves travel through mutex-protected deques, and it's the mutexes that provide the
+ * ordering. Relaxed operations stay atomic, so the counters never tear or lose updates.
+*/
@@ -1,4 +1,6 @@
+#include <cstddef>
 #include <string>
+#include <utility>
 #include <vector>
 /**
  * Consider pass by value for copyable parameters that are cheap to move and always copied.
@@ -107,3 +109,250 @@ class Widget
  * The traditional advice of avoiding pass-by-value for user-defined types still holds, but C++11's move
  * semantics offer new options and considerations.
 */
+
+
+/**
+ * Measuring the Three Designs:
+ * The counts above can be checked. The widgets below are the three designs again, templated on the string type and
+ * given reserve and clear, so the vector's own reallocation stays out of the picture. reportAddNameMatrix instantiates
+ * them with TrackedString from Item 42, which counts copies, moves and (through CountingAllocator) heap allocations,
+ * and calls addName with an lvalue, an rvalue and a string literal, at 5 characters (inside the small string buffer)
+ * and 30 characters (outside it). Counts are per call and include constructing the argument, e.g. the rvalue's own
+ * allocation.
+ *
+ * The by-value design shows one extra move for lvalues. For the rvalue and literal arguments here, which are prvalues,
+ * it matches the other two: since C++17 a prvalue initializes the parameter directly, so the "two moves" case needs an
+ * xvalue such as std::move(name). At 30 characters the extra move is only a pointer swap, never an extra allocation,
+ * because moving a long string steals its buffer.
+*/
+template<typename String = std::string>
+class OverloadingWidget
+{
+    public:
+        void addName(const String& newName) { names.push_back(newName); }
+        void addName(String&& newName) { names.push_back(std::move(newName)); }
+
+        void reserve(std::size_t n) { names.reserve(n); }
+        void clear() noexcept { names.clear(); }
+        std::size_t size() const noexcept { return names.size(); }
+
+    private:
+        std::vector<String> names;
+};
+
+template<typename String = std::string>
+class ForwardingWidget
+{
+    public:
+        template<typename T>
+        void addName(T&& newName) { names.push_back(std::forward<T>(newName)); }
+
+        void reserve(std::size_t n) { names.reserve(n); }
+        void clear() noexcept { names.clear(); }
+        std::size_t size() const noexcept { return names.size(); }
+
+    private:
+        std::vector<String> names;
+};
+
+template<typename String = std::string>
+class ByValueWidget
+{
+    public:
+        void addName(String newName) { names.push_back(std::move(newName)); }
+
+        void reserve(std::size_t n) { names.reserve(n); }
+        void clear() noexcept { names.clear(); }
+        std::size_t size() const noexcept { return names.size(); }
+
+    private:
+        std::vector<String> names;
+};
+
+
+/**
+ * Copying by Assignment:
+ * The Item's caveat cuts the other way too: copy assignment can reuse memory that copy construction has to allocate.
+ * SlotWidget keeps its names after clear and, while a slot is available, copy-assigns (or move-assigns) each new name
+ * into an existing std::string. Once reserve has sized the slots for the longest expected name, adding an lvalue name
+ * doesn't allocate at all, at any length. The price is that names keep their memory until the widget goes away, and
+ * rvalue arguments still move, which hands the slot's buffer to the caller's temporary.
+*/
+template<typename String = std::string>
+class SlotWidget
+{
+    public:
+        void addName(const String& newName)
+        {
+            if (used < names.size())
+            {
+                names[used] = newName;                  // Reuses the slot's capacity
+            }
+            else
+            {
+                names.push_back(newName);
+            }
+
+            ++used;
+        }
+
+        void addName(String&& newName)
+        {
+            if (used < names.size())
+            {
+                names[used] = std::move(newName);
+            }
+            else
+            {
+                names.push_back(std::move(newName));
+            }
+
+            ++used;
+        }
+
+        // n slots, each with room for a name of up to maxLength characters
+        void reserve(std::size_t n, std::size_t maxLength = 0)
+        {
+            names.reserve(n);
+
+            while (names.size() < n)
+            {
+                names.push_back(String(std::string(maxLength, ' ').c_str()));
+            }
+        }
+
+        void clear() noexcept { used = 0; }                 // Keep the strings, and their buffers
+        std::size_t size() const noexcept { return used; }
+
+    private:
+        std::vector<String> names;
+        std::size_t used = 0;
+};
+
+template<typename Widget>
+void reportAddName(const std::string& design, std::size_t repetitions = 10'000)
+{
+    for (std::size_t length : { 5, 30 })
+    {
+        const std::string text(length, 'x');
+        const char* s = text.c_str();
+        const TrackedString lvalue(s);
+        const auto suffix = " (" + std::to_string(length) + " chars)";
+
+        auto prepared = [&]
+        {
+            Widget w;
+
+            if constexpr (requires { w.reserve(repetitions, length); })
+            {
+                w.reserve(repetitions, length);
+            }
+            else
+            {
+                w.reserve(repetitions);
+            }
+
+            return w;
+        };
+
+        auto w1 = prepared();
+        reportOperation(design + ", lvalue" + suffix, repetitions, [&](std::size_t) { w1.addName(lvalue); });
+
+        auto w2 = prepared();
+        reportOperation(design + ", rvalue" + suffix, repetitions, [&](std::size_t) { w2.addName(TrackedString(s)); });
+
+        auto w3 = prepared();
+        reportOperation(design + ", literal" + suffix, repetitions, [&](std::size_t) { w3.addName(s); });
+    }
+}
+
+inline void reportAddNameMatrix()
+{
+    reportAddName<OverloadingWidget<TrackedString>>("overloads");
+    reportAddName<ForwardingWidget<TrackedString>>("universal reference");
+    reportAddName<ByValueWidget<TrackedString>>("pass by value");
+    reportAddName<SlotWidget<TrackedString>>("slot reuse");
+}
+
+reportAddNameMatrix();
+
+
+/**
+ * Checking the Counts:
+ * The matrix prints counts; checkAddNamePatterns holds the designs to them, with Item 25's expectCounts, so a change
+ * that adds a copy or a move to addName stops the program at start-up. Each check builds its widget inside the
+ * operation, so every TrackedString it creates is also destroyed there. The by-value expectations are the Item's: one
+ * copy and one move for lvalues, one move for prvalues and literals, and two moves for an xvalue.
+*/
+template<typename Widget>
+void checkAddName(const std::string& design, ExpectedCounts lvalue, ExpectedCounts rvalue, ExpectedCounts xvalue,
+                  ExpectedCounts literal)
+{
+    const TrackedString name("name");
+
+    auto withWidget = [](auto add)
+    {
+        return [add]
+        {
+            Widget w;
+            w.reserve(1);
+            add(w);
+        };
+    };
+
+    expectCounts(design + ", lvalue", lvalue, withWidget([&](Widget& w) { w.addName(name); }));
+    expectCounts(design + ", prvalue", rvalue, withWidget([](Widget& w) { w.addName(TrackedString("name")); }));
+    expectCounts(design + ", xvalue", xvalue, withWidget([](Widget& w)
+                 {
+                     TrackedString local("name");
+                     w.addName(std::move(local));
+                 }));
+    expectCounts(design + ", literal", literal, withWidget([](Widget& w) { w.addName("name"); }));
+}
+
+inline void checkAddNamePatterns()
+{
+    checkAddName<OverloadingWidget<TrackedString>>("overloads", { 1, 0 }, { 0, 1 }, { 0, 1 }, { 0, 1 });
+    checkAddName<ForwardingWidget<TrackedString>>("universal reference", { 1, 0 }, { 0, 1 }, { 0, 1 }, { 0, 1 });
+    checkAddName<ByValueWidget<TrackedString>>("pass by value", { 1, 1 }, { 0, 1 }, { 0, 2 }, { 0, 1 });
+}
+
+checkAddNamePatterns();
+
+
+/**
+ * Benchmarks:
+ * Each iteration clears a widget and adds 64 copies of the same std::string lvalue, at 5 and 30 characters (see Item 24
+ * for registerBenchmark). The first three designs allocate once per name at 30 characters; SlotWidget doesn't.
+*/
+constexpr std::size_t namesPerIteration = 64;
+
+template<typename Widget>
+void registerAddNameBenchmark(const std::string& design, std::size_t length)
+{
+    registerBenchmark("Item 41/" + design + ", lvalue (" + std::to_string(length) + " chars)",
+                      [name = std::string(length, 'x'), w = Widget()]() mutable
+                      {
+                          w.clear();
+
+                          for (std::size_t i = 0; i < namesPerIteration; ++i)
+                          {
+                              w.addName(name);
+                          }
+
+                          return w.size();
+                      });
+}
+
+inline const bool item41Registered = []
+{
+    for (std::size_t length : { 5, 30 })
+    {
+        registerAddNameBenchmark<OverloadingWidget<>>("overloads", length);
+        registerAddNameBenchmark<ForwardingWidget<>>("universal reference", length);
+        registerAddNameBenchmark<ByValueWidget<>>("pass by value", length);
+        registerAddNameBenchmark<SlotWidget<>>("slot reuse", length);
+    }
+
+    return true;
+}();
@@ -1,6 +1,13 @@
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <list>
 #include <memory>
 #include <regex>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 /**
  * Consider emplacement instead of insertion.
@@ -92,3 +99,282 @@ regexes.emplace_back(nullptr);      // Compiles. Direct init permits use of expl
  * particularly beneficial for in-place construction and when argument types differ from the container's type.
  * However, in some cases, insertion functions might be safer or more appropriate.
 */
+
+
+/**
+ * Measuring Insertion vs. Emplacement:
+ * Whether emplacement wins depends on the three conditions at the top of this Item, so the claims are checked by
+ * counting rather than argued. Two instruments are needed:
+ *
+ * - CountingAllocator counts the allocations a container (or a string) makes, and how many bytes it asks for.
+ *
+ * - TrackedString wraps a string that uses CountingAllocator and counts how it is constructed: from a literal, by copy,
+ *   by move, or by copy or move assignment. It also counts destructions, so a check can confirm every object it made
+ *   was destroyed (see Item 25).
+ *
+ * reportOperation resets the counters, performs an operation a number of times, and prints the counts per operation.
+ *
+ * ---------------------------------------------------------------------------------------------------------------------
+ *
+ * Where SSO Changes the Picture:
+ * The temporary that push_back needs is moved into the container, and a move steals a heap buffer, so insertion and
+ * emplacement make the same number of allocations at every length. What the string length changes is the cost of that
+ * extra move. Up to the small string limit (15 characters in libstdc++, 22 in libc++) the characters live inside the
+ * string object, and moving it copies them, so the move costs as much as a copy (see Item 29). Past the limit the move
+ * is a few pointer assignments.
+*/
+struct OperationCounts
+{
+    std::size_t allocations = 0, bytesAllocated = 0;
+    std::size_t fromLiteral = 0, copies = 0, moves = 0, copyAssignments = 0, moveAssignments = 0;
+    std::size_t destructions = 0;
+};
+
+inline OperationCounts counts;
+
+template<typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator() noexcept = default;
+
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+        ++counts.allocations;
+        counts.bytesAllocated += n * sizeof(T);
+
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+};
+
+using CountedString = std::basic_string<char, std::char_traits<char>, CountingAllocator<char>>;
+
+class TrackedString
+{
+    public:
+        TrackedString(const char* s) : value(s) { ++counts.fromLiteral; }
+
+        TrackedString(const TrackedString& rhs) : value(rhs.value) { ++counts.copies; }
+        TrackedString(TrackedString&& rhs) noexcept : value(std::move(rhs.value)) { ++counts.moves; }
+
+        ~TrackedString() { ++counts.destructions; }
+
+        TrackedString& operator=(const TrackedString& rhs)
+        {
+            value = rhs.value;
+            ++counts.copyAssignments;
+
+            return *this;
+        }
+
+        TrackedString& operator=(TrackedString&& rhs) noexcept
+        {
+            value = std::move(rhs.value);
+            ++counts.moveAssignments;
+
+            return *this;
+        }
+
+        // For std::set and std::unordered_map
+        friend bool operator<(const TrackedString& lhs, const TrackedString& rhs) { return lhs.value < rhs.value; }
+        friend bool operator==(const TrackedString& lhs, const TrackedString& rhs) { return lhs.value == rhs.value; }
+
+        const CountedString& str() const noexcept { return value; }
+
+    private:
+        CountedString value;
+};
+
+template<>
+struct std::hash<TrackedString>
+{
+    std::size_t operator()(const TrackedString& s) const noexcept
+    {
+        return std::hash<std::string_view>{ }(std::string_view(s.str().data(), s.str().size()));
+    }
+};
+
+template<typename Operation>
+void reportOperation(const std::string& label, std::size_t repetitions, Operation op)
+{
+    counts = { };
+
+    for (std::size_t i = 0; i < repetitions; ++i)
+    {
+        op(i);
+    }
+
+    auto perOp = [repetitions](std::size_t n) { return static_cast<double>(n) / repetitions; };
+
+    std::cout << label << ": " << perOp(counts.allocations) << " allocations (" << perOp(counts.bytesAllocated)
+              << " bytes), " << perOp(counts.fromLiteral) << " from literal, " << perOp(counts.copies) << " copies, "
+              << perOp(counts.moves) << " moves, " << perOp(counts.copyAssignments) << " copy assignments, "
+              << perOp(counts.moveAssignments) << " move assignments per operation\n";
+}
+
+
+/**
+ * The Matrix:
+ * Each container gets the same value added by insertion and by emplacement, at each string length:
+ *
+ * - vector, deque and list: push_back(TrackedString(s)) vs. emplace_back(s). Constructed into the container, with a
+ *   type mismatch: emplacement saves a temporary, a move, and a destruction.
+ *
+ * - vector at the front: insert(begin(), TrackedString(s)) vs. emplace(begin(), s). The new value is move-assigned into
+ *   an existing slot, so emplace_back's advantage disappears: emplacement builds a temporary too.
+ *
+ * - set and unordered_map with a value that's already present: insert vs. emplace. Emplacement has to build a node to
+ *   compare against, then throws it away. For std::set that's one allocation more than insert, which compares the
+ *   temporary directly; for std::unordered_map, insert of a braced pair copies the key besides, so the two come closer.
+ *
+ * - vector<std::regex>: push_back(std::regex(pattern)) vs. emplace_back(pattern). Only the vector's own allocations are
+ *   counted; std::regex allocates internally through std::allocator, which no container allocator can see.
+*/
+template<typename T>
+using CountedVector = std::vector<T, CountingAllocator<T>>;
+
+void reportEmplacementMatrix(std::size_t repetitions = 10'000)
+{
+    for (std::size_t length : { 5, 15, 16, 22, 23, 64 })
+    {
+        const std::string text(length, 'x');
+        const char* s = text.c_str();
+        const auto suffix = " (" + std::to_string(length) + " chars)";
+
+        {
+            CountedVector<TrackedString> v;
+            v.reserve(repetitions);             // Keep reallocation out of the per-operation counts
+            reportOperation("vector push_back" + suffix, repetitions, [&](std::size_t)
+                            { v.push_back(TrackedString(s)); });
+        }
+        {
+            CountedVector<TrackedString> v;
+            v.reserve(repetitions);
+            reportOperation("vector emplace_back" + suffix, repetitions, [&](std::size_t) { v.emplace_back(s); });
+        }
+        {
+            std::deque<TrackedString, CountingAllocator<TrackedString>> d;
+            reportOperation("deque push_back" + suffix, repetitions, [&](std::size_t)
+                            { d.push_back(TrackedString(s)); });
+        }
+        {
+            std::deque<TrackedString, CountingAllocator<TrackedString>> d;
+            reportOperation("deque emplace_back" + suffix, repetitions, [&](std::size_t) { d.emplace_back(s); });
+        }
+        {
+            std::list<TrackedString, CountingAllocator<TrackedString>> l;
+            reportOperation("list push_back" + suffix, repetitions, [&](std::size_t) { l.push_back(TrackedString(s)); });
+        }
+        {
+            std::list<TrackedString, CountingAllocator<TrackedString>> l;
+            reportOperation("list emplace_back" + suffix, repetitions, [&](std::size_t) { l.emplace_back(s); });
+        }
+
+        // Assignment rather than construction: a few elements, re-inserted at the front
+        {
+            CountedVector<TrackedString> v(8, TrackedString(s));
+            v.reserve(8 + repetitions);
+            reportOperation("vector insert at begin" + suffix, 100, [&](std::size_t)
+                            { v.insert(v.begin(), TrackedString(s)); });
+        }
+        {
+            CountedVector<TrackedString> v(8, TrackedString(s));
+            v.reserve(8 + repetitions);
+            reportOperation("vector emplace at begin" + suffix, 100, [&](std::size_t) { v.emplace(v.begin(), s); });
+        }
+
+        // Duplicates: the value is inserted once up front, so every measured call is rejected
+        {
+            std::set<TrackedString, std::less<TrackedString>, CountingAllocator<TrackedString>> set { TrackedString(s) };
+            reportOperation("set insert duplicate" + suffix, repetitions, [&](std::size_t)
+                            { set.insert(TrackedString(s)); });
+        }
+        {
+            std::set<TrackedString, std::less<TrackedString>, CountingAllocator<TrackedString>> set { TrackedString(s) };
+            reportOperation("set emplace duplicate" + suffix, repetitions, [&](std::size_t) { set.emplace(s); });
+        }
+        {
+            using Map = std::unordered_map<TrackedString, int, std::hash<TrackedString>, std::equal_to<TrackedString>,
+                                           CountingAllocator<std::pair<const TrackedString, int>>>;
+            Map map { { TrackedString(s), 0 } };
+            reportOperation("unordered_map insert duplicate" + suffix, repetitions, [&](std::size_t)
+                            { map.insert({ TrackedString(s), 0 }); });
+        }
+        {
+            using Map = std::unordered_map<TrackedString, int, std::hash<TrackedString>, std::equal_to<TrackedString>,
+                                           CountingAllocator<std::pair<const TrackedString, int>>>;
+            Map map { { TrackedString(s), 0 } };
+            reportOperation("unordered_map emplace duplicate" + suffix, repetitions, [&](std::size_t)
+                            { map.emplace(s, 0); });
+        }
+    }
+
+    const std::string pattern = "[a-z]+[0-9]*";
+    {
+        CountedVector<std::regex> regexes;
+        reportOperation("vector<regex> push_back", 1'000, [&](std::size_t)
+                        { regexes.push_back(std::regex(pattern)); });
+    }
+    {
+        CountedVector<std::regex> regexes;
+        reportOperation("vector<regex> emplace_back", 1'000, [&](std::size_t) { regexes.emplace_back(pattern); });
+    }
+}
+
+
+/**
+ * Benchmarks:
+ * Counts say what happens; timings say what it costs. The same vector operations are registered with the Item 24
+ * harness at an SSO length and a heap length. The vectors are cleared every 1,000 operations so the timings don't
+ * include unbounded growth.
+*/
+inline const bool item42Registered = []
+{
+    for (std::size_t length : { 5, 64 })
+    {
+        const auto suffix = " (" + std::to_string(length) + " chars)";
+
+        registerBenchmark("Item 42/vector push_back" + suffix,
+                          [text = std::string(length, 'x'), v = CountedVector<TrackedString>()]() mutable
+                          {
+                              if (v.size() == 1'000)
+                              {
+                                  v.clear();
+                              }
+
+                              v.push_back(TrackedString(text.c_str()));
+
+                              return v.size();
+                          });
+
+        registerBenchmark("Item 42/vector emplace_back" + suffix,
+                          [text = std::string(length, 'x'), v = CountedVector<TrackedString>()]() mutable
+                          {
+                              if (v.size() == 1'000)
+                              {
+                                  v.clear();
+                              }
+
+                              v.emplace_back(text.c_str());
+
+                              return v.size();
+                          });
+    }
+
+    return true;
+}();